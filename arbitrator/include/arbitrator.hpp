@@ -22,7 +22,9 @@
 #include "arbitrator_state_machine.hpp"
 #include "planning_strategy.hpp"
 #include "capabilities_interface.hpp"
+#include "planning_tracer.hpp"
 #include <cav_msgs/GuidanceState.h>
+#include <cav_msgs/ManeuverPlan.h>
 
 namespace arbitrator 
 {
@@ -45,6 +47,9 @@ namespace arbitrator
              * \param planning_strategy A planning strategy implementation for generating plans
              * \param min_plan_duration The minimum acceptable length of a plan
              * \param planning_frequency The frequency at which to generate high-level plans when engaged
+             * \param warm_start If true, each planning cycle is seeded with the unexpired portion of the
+             *      previously published plan rather than planning from scratch
+             * \param tracer An optional PlanningTracer whose per-cycle records are published as diagnostics
              */ 
             Arbitrator(ros::CARMANodeHandle *nh, 
                 ros::CARMANodeHandle *pnh, 
@@ -52,7 +57,9 @@ namespace arbitrator
                 CapabilitiesInterface *ci, 
                 const PlanningStrategy &planning_strategy,
                 ros::Duration min_plan_duration,
-                ros::Rate planning_frequency):
+                ros::Rate planning_frequency,
+                bool warm_start = false,
+                PlanningTracer *tracer = nullptr):
                 sm_(sm),
                 nh_(nh),
                 pnh_(pnh),
@@ -60,15 +67,25 @@ namespace arbitrator
                 planning_strategy_(planning_strategy),
                 initialized_(false),
                 min_plan_duration_(min_plan_duration),
-                time_between_plans_(planning_frequency.expectedCycleTime()) {};
+                time_between_plans_(planning_frequency.expectedCycleTime()),
+                warm_start_(warm_start),
+                tracer_(tracer) {};
             
             /**
              * \brief Begin the operation of the arbitrator.
              * 
-             * Loops internally via ros::Duration sleeps and spins
+             * Initializes the arbitrator and then spins, with all state transitions
+             * driven by guidance state callbacks and the planning timer
              */
             void run();
         protected:
+            /**
+             * \brief Submit an event to the state machine and execute the function
+             *      associated with the resulting state, if the state changed
+             * \param event The event to submit
+             */
+            void handle_event(ArbitratorEvent event);
+
             /**
              * \brief Function to be executed during the initial state of the Arbitrator
              */
@@ -81,13 +98,13 @@ namespace arbitrator
 
             /**
              * \brief Function to be executed when the Arbitrator has finished planning
-             * and is awaiting another planning cycle
+             * and is awaiting another planning cycle. Schedules the next planning cycle.
              */
             void waiting_state();
 
             /**
              * \brief Function to be executed when the Arbitrator is not planning but also
-             * not awaiting a new plan cycle
+             * not awaiting a new plan cycle. Cancels any scheduled planning cycle.
              */
             void paused_state();
 
@@ -102,10 +119,23 @@ namespace arbitrator
              */
             void guidance_state_cb(const cav_msgs::GuidanceState::ConstPtr& msg);
 
+            /**
+             * \brief Callback for the planning timer, triggers the next planning cycle
+             * \param te The timer event that triggered this callback
+             */
+            void planning_timer_cb(const ros::TimerEvent& te);
+
+            /**
+             * \brief Publish the statistics of the last planning cycle on the ROS diagnostics topic
+             */
+            void publish_planning_diagnostics();
+
         private:
             ArbitratorStateMachine *sm_;
             ros::Publisher final_plan_pub_;
+            ros::Publisher diagnostics_pub_;
             ros::Subscriber guidance_state_sub_;
+            ros::Timer planning_timer_;
             ros::CARMANodeHandle *nh_;
             ros::CARMANodeHandle *pnh_;
             ros::Duration min_plan_duration_;
@@ -114,6 +144,9 @@ namespace arbitrator
             CapabilitiesInterface *capabilities_interface_;
             const PlanningStrategy &planning_strategy_;
             bool initialized_;
+            bool warm_start_;
+            cav_msgs::ManeuverPlan latest_plan_;
+            PlanningTracer *tracer_;
     };
 };
 
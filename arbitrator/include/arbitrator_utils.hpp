@@ -40,6 +40,21 @@
 
 namespace arbitrator_utils
 {
+    /**
+     * \brief The fields shared by all maneuver types, resolved from a maneuver
+     *      with a single check of its type
+     */
+    struct ManeuverProperties
+    {
+        const cav_msgs::ManeuverParameters *parameters;
+        ros::Time start_time;
+        ros::Time end_time;
+        double start_dist;
+        double end_dist;
+        double start_speed;
+        double end_speed;
+    };
+
     /**
      * \brief Get the start time of the first maneuver in the plan
      * \param plan The plan to examine
@@ -72,6 +87,18 @@ namespace arbitrator_utils
      */
     double get_plan_end_distance(const cav_msgs::ManeuverPlan&);
 
+    /**
+     * \brief Get the duration of the plan which remains after a point in time
+     * 
+     * Maneuvers already in progress at that time only count for their remaining part.
+     * 
+     * \param plan The plan to examine
+     * \param from The time from which the remaining duration is measured
+     * \return The time between the later of the plan start time and from, and the plan end time
+     * \throws An invalid argument exception if the plan is empty
+     */
+    ros::Duration get_plan_remaining_duration(const cav_msgs::ManeuverPlan&, ros::Time);
+
     /**
      * \brief Get the start time of the specified maneuver
      * \param mvr The maneuver to examine
@@ -103,6 +130,23 @@ namespace arbitrator_utils
      * \throws An invalid argument exception if the maneuver is poorly constructed
      */
     double get_maneuver_end_distance(const cav_msgs::Maneuver&);
+
+    /**
+     * \brief Get all the fields shared across maneuver types from the specified maneuver
+     * \param mvr The maneuver to examine
+     * \return The properties of the maneuver. The parameters pointer refers into mvr
+     *      and is only valid for its lifetime.
+     * \throws An invalid argument exception if the maneuver is poorly constructed
+     */
+    ManeuverProperties get_maneuver_properties(const cav_msgs::Maneuver&);
+
+    /**
+     * \brief Get the portion of a plan which has not yet expired
+     * \param plan The plan to examine
+     * \param current_time The time against which maneuver end times are compared
+     * \return A copy of the plan containing only the maneuvers which end after current_time
+     */
+    cav_msgs::ManeuverPlan get_unexpired_plan(const cav_msgs::ManeuverPlan&, ros::Time);
 } // namespace arbitrator
 
 #endif //__ARBITRATOR_INCLUDE_ARBITRATOR_UTILS_HPP__
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __ARBITRATOR_INCLUDE_CACHING_NEIGHBOR_GENERATOR_HPP__
+#define __ARBITRATOR_INCLUDE_CACHING_NEIGHBOR_GENERATOR_HPP__
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ros/ros.h>
+#include <cav_msgs/ManeuverPlan.h>
+#include "neighbor_generator.hpp"
+
+namespace arbitrator
+{
+    /**
+     * \brief Decorator for a NeighborGenerator which memoizes its results
+     * 
+     * Responses are keyed by the identity of the maneuvers in the plan being
+     * expanded (the prior-plan prefix), so repeated expansion of the same
+     * plan across planning cycles is answered without re-querying the wrapped
+     * generator. Entries are held for a fixed time-to-live, after which the
+     * wrapped generator is queried again. The empty root plan is never cached,
+     * as its expansion depends on the current vehicle state.
+     * 
+     * Safe to call from multiple threads if the wrapped generator is.
+     */
+    class CachingNeighborGenerator : public NeighborGenerator
+    {
+        public:
+            /**
+             * \brief Constructor for CachingNeighborGenerator
+             * \param ng The NeighborGenerator whose results are to be cached
+             * \param ttl How long a cached response remains valid. A zero or negative
+             *      duration disables caching entirely.
+             */
+            CachingNeighborGenerator(const NeighborGenerator &ng, ros::Duration ttl) :
+                neighbor_generator_(ng),
+                ttl_(ttl) {};
+
+            /**
+             * \brief Generate the neighbors of a plan, using a cached response if 
+             *      one exists for an identical plan
+             * \param plan The plan that is the current search state
+             * \return A list of subsequent plans building on top of the input plan
+             */
+            std::vector<cav_msgs::ManeuverPlan> generate_neighbors(cav_msgs::ManeuverPlan plan) const;
+
+            /**
+             * \brief Compute the cache key identifying a plan by its maneuvers
+             * \param plan The plan to identify
+             * \return A string uniquely identifying the sequence of maneuvers in the plan
+             */
+            static std::string compute_key(const cav_msgs::ManeuverPlan &plan);
+        private:
+            struct CacheEntry
+            {
+                ros::Time stored_at;
+                std::vector<cav_msgs::ManeuverPlan> neighbors;
+            };
+
+            const NeighborGenerator &neighbor_generator_;
+            ros::Duration ttl_;
+            mutable std::map<std::string, CacheEntry> cache_;
+            mutable std::mutex cache_mutex_;
+    };
+};
+
+#endif //__ARBITRATOR_INCLUDE_CACHING_NEIGHBOR_GENERATOR_HPP__
@@ -21,10 +21,13 @@
 #include <carma_utils/CARMAUtils.h>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <unordered_set>
 #include <string>
 #include <cav_srvs/PluginList.h>
 #include <cav_srvs/GetPluginApi.h>
+#include "planning_tracer.hpp"
+#include "worker_pool.hpp"
 
 namespace arbitrator
 {
@@ -38,8 +41,12 @@ namespace arbitrator
             /**
              * \brief Constructor for Capabilities interface
              * \param nh A publically addressesed ("/") ros::NodeHandle
+             * \param tracer An optional PlanningTracer to report plugin call latencies to
+             * \param max_concurrent_calls The maximum number of plugins to call concurrently
+             *      when multiplexing a service call
              */
-            CapabilitiesInterface(ros::NodeHandle *nh): nh_(nh) {
+            CapabilitiesInterface(ros::NodeHandle *nh, PlanningTracer *tracer = nullptr, size_t max_concurrent_calls = 1): 
+                nh_(nh), tracer_(tracer), call_pool_(max_concurrent_calls) {
                 sc_s = nh_->serviceClient<cav_srvs::GetPluginApi>("plugins/get_strategic_plugin_by_capability");
             };
 
@@ -76,8 +83,12 @@ namespace arbitrator
         protected:
         private:
             ros::NodeHandle *nh_;
+            PlanningTracer *tracer_;
+            // Shared by multiplexed calls issued concurrently from parallel plan expansions
+            WorkerPool call_pool_;
 
             ros::ServiceClient sc_s;
+            std::mutex sc_s_mutex_;
             std::unordered_set <std::string> capabilities_ ; 
 
 
@@ -21,6 +21,7 @@
 #include <map>
 #include <string>
 #include <functional>
+#include <utility>
 #include <cav_srvs/PlanManeuvers.h>
 
 namespace arbitrator 
@@ -29,12 +30,25 @@ namespace arbitrator
     std::map<std::string, MSrv> CapabilitiesInterface::multiplex_service_call_for_capability(std::string query_string, MSrv msg)
     {
         std::vector<std::string> topics = get_topics_for_capability(query_string);
+        std::vector<MSrv> results(topics.size(), msg);
+        std::vector<char> succeeded(topics.size(), false);
+
+        // Each plugin is called with its own copy of the request so calls may run concurrently
+        call_pool_.parallel_for(topics.size(), [&](size_t idx)
+        {
+            ros::ServiceClient sc = nh_->serviceClient<cav_srvs::PlanManeuvers>(topics[idx]);
+            PlanningTracer::Clock::time_point call_start = PlanningTracer::Clock::now();
+            succeeded[idx] = sc.call(results[idx]);
+            if (tracer_ != nullptr) {
+                tracer_->record_plugin_call(topics[idx], call_start, PlanningTracer::Clock::now(), succeeded[idx]);
+            }
+        });
+
         std::map<std::string, MSrv> responses;
-        for (auto i = topics.begin(); i != topics.end(); i++) 
+        for (size_t i = 0; i < topics.size(); i++) 
         {
-            ros::ServiceClient sc = nh_->serviceClient<cav_srvs::PlanManeuvers>(*i);
-            if (sc.call(msg)) {
-                responses.emplace(*i, msg);
+            if (succeeded[i]) {
+                responses.emplace(topics[i], std::move(results[i]));
             }
         }
         return responses;
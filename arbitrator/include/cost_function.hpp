@@ -17,7 +17,9 @@
 #ifndef __ARBITRATOR_INCLUDE_COST_FUNCTION_HPP__
 #define __ARBITRATOR_INCLUDE_COST_FUNCTION_HPP__
 
-#include <cav_msgs/ManeuverPlan.h>
+#include <map>
+#include <string>
+#include <vector>
 #include <cav_msgs/ManeuverPlan.h>
 
 namespace arbitrator
@@ -34,14 +36,51 @@ namespace arbitrator
              * \param plan The plan to evaluate
              * \return double The total cost
              */
-            virtual double compute_total_cost(cav_msgs::ManeuverPlan plan) const = 0;
+            virtual double compute_total_cost(const cav_msgs::ManeuverPlan &plan) const = 0;
 
             /**
              * \brief Compute the unit cost over distance of a given maneuver plan
              * \param plan The plan to evaluate
              * \return double The total cost divided by the total distance of the plan
              */
-            virtual double compute_cost_per_unit_distance(cav_msgs::ManeuverPlan plan) const = 0;
+            virtual double compute_cost_per_unit_distance(const cav_msgs::ManeuverPlan &plan) const = 0;
+
+            /**
+             * \brief Compute the unit cost over distance of each child of a plan
+             * 
+             * Children usually begin with the maneuvers of the parent, which
+             * implementations may use to avoid re-evaluating the shared prefix
+             * after checking that it is unchanged. The default implementation
+             * evaluates each child independently.
+             * 
+             * \param parent The plan which was expanded to produce the children
+             * \param children The plans to evaluate
+             * \return The unit cost of each child, in the same order as children
+             */
+            virtual std::vector<double> compute_costs_per_unit_distance(const cav_msgs::ManeuverPlan &parent, 
+                const std::vector<cav_msgs::ManeuverPlan> &children) const
+            {
+                std::vector<double> costs;
+                costs.reserve(children.size());
+                for (auto it = children.begin(); it != children.end(); it++)
+                {
+                    costs.push_back(compute_cost_per_unit_distance(*it));
+                }
+                return costs;
+            }
+
+            /**
+             * \brief Compute the named terms making up the total cost of a plan, for diagnostics
+             * 
+             * The default implementation reports only the total cost.
+             * 
+             * \param plan The plan to evaluate
+             * \return A map of term name -> cost contributed by that term
+             */
+            virtual std::map<std::string, double> compute_cost_terms(const cav_msgs::ManeuverPlan &plan) const
+            {
+                return {{"total", compute_total_cost(plan)}};
+            }
 
             /**
              * \brief Virtual destructor provided for memory safety
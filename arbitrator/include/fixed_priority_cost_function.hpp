@@ -19,6 +19,8 @@
 
 #include "cost_function.hpp"
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include <string>
 
 namespace arbitrator
@@ -39,25 +41,80 @@ namespace arbitrator
         public:
             /**
              * \brief Constructor for FixedPriorityCostFunction
-             * \param nh A publically namespaced ("/") ros::NodeHandle
+             * 
+             * Plugin names are mapped to indices into a flat cost table at
+             * construction time, so evaluating a maneuver costs a single hash
+             * lookup of its plugin name.
+             * 
+             * \param plugin_priorities A map of plugin name -> plugin priority
              */
             FixedPriorityCostFunction(const std::map<std::string, double> &plugin_priorities);
 
             /**
-             * \brief Compute the unit cost over distance of a given maneuver plan
+             * \brief Compute the total cost of a given maneuver plan
              * \param plan The plan to evaluate
-             * \return double The total cost divided by the total distance of the plan
+             * \return double The total cost
              */
-            double compute_total_cost(cav_msgs::ManeuverPlan plan) const;
+            double compute_total_cost(const cav_msgs::ManeuverPlan &plan) const;
 
             /**
              * \brief Compute the unit cost over distance of a given maneuver plan
              * \param plan The plan to evaluate
              * \return double The total cost divided by the total distance of the plan
              */
-            double compute_cost_per_unit_distance(cav_msgs::ManeuverPlan plan) const;
+            double compute_cost_per_unit_distance(const cav_msgs::ManeuverPlan &plan) const;
+
+            /**
+             * \brief Compute the unit cost over distance of each child of a plan
+             * 
+             * The cost of the parent is evaluated once, after which only the
+             * maneuvers appended by each child are evaluated. Children which do
+             * not begin with the parent's maneuver ids are evaluated in full.
+             * 
+             * \param parent The plan which was expanded to produce the children
+             * \param children The plans to evaluate
+             * \return The unit cost of each child, in the same order as children
+             */
+            std::vector<double> compute_costs_per_unit_distance(const cav_msgs::ManeuverPlan &parent, 
+                const std::vector<cav_msgs::ManeuverPlan> &children) const;
+
+            /**
+             * \brief Get the normalized cost per unit distance of a plugin
+             * \param planning_plugin The name of the plugin
+             * \return The cost per unit distance of maneuvers planned by the plugin
+             * \throws std::out_of_range if the plugin has no configured priority
+             */
+            double get_plugin_cost(const std::string &planning_plugin) const;
         private:
-            std::map<std::string, double> plugin_costs_;
+            /**
+             * \brief Compute the summed cost of a range of maneuvers in a plan
+             * \param plan The plan containing the maneuvers
+             * \param first The index of the first maneuver to evaluate
+             * \return The cost of maneuvers [first, end) of the plan
+             */
+            double compute_maneuvers_cost(const cav_msgs::ManeuverPlan &plan, size_t first) const;
+
+            /**
+             * \brief Compute the cost of a single maneuver
+             * \param mvr The maneuver to evaluate
+             * \return The maneuver's distance multiplied by its planning plugin's cost
+             */
+            double compute_maneuver_cost(const cav_msgs::Maneuver &mvr) const;
+
+            /**
+             * \brief Check whether a plan begins with the maneuvers of another plan
+             * 
+             * Only maneuver ids are compared, which is much cheaper than
+             * looking up the plugin cost of each prefix maneuver again.
+             * 
+             * \param plan The plan to examine
+             * \param prefix The plan whose maneuvers plan must begin with
+             * \return True if every maneuver of prefix has a non-empty id equal to that of the maneuver at the same index of plan
+             */
+            bool has_cost_prefix(const cav_msgs::ManeuverPlan &plan, const cav_msgs::ManeuverPlan &prefix) const;
+
+            std::unordered_map<std::string, size_t> plugin_ids_;
+            std::vector<double> plugin_costs_;
     };
 };
 
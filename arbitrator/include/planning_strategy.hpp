@@ -34,6 +34,23 @@ namespace arbitrator
              */
             virtual cav_msgs::ManeuverPlan generate_plan() const = 0;
 
+            /**
+             * \brief Generate a plausible maneuver plan which begins with the
+             *      maneuvers of an existing plan
+             * 
+             * Implementations which cannot make use of a prior plan may ignore
+             * it, which is the default behavior.
+             * 
+             * \param seed A (possibly empty) plan whose maneuvers the new plan must start with
+             * \param planning_start The time planning began. Plan duration is measured from
+             *      this time, so the elapsed part of an in progress seed maneuver does not count.
+             * \return A maneuver plan from the vehicle's current state
+             */
+            virtual cav_msgs::ManeuverPlan generate_plan(const cav_msgs::ManeuverPlan &seed, ros::Time planning_start) const
+            {
+                return generate_plan();
+            }
+
             /**
              * \brief Virtual destructor provided for memory safety
              */
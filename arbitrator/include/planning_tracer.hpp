@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __ARBITRATOR_INCLUDE_PLANNING_TRACER_HPP__
+#define __ARBITRATOR_INCLUDE_PLANNING_TRACER_HPP__
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace arbitrator
+{
+    /**
+     * \brief A single timed span within a planning cycle, in the form used by
+     *      the Chrome trace event format
+     */
+    struct TraceEvent
+    {
+        std::string name;
+        std::string category;
+        double start_us;
+        double duration_us;
+        int thread_index;
+    };
+
+    /**
+     * \brief Aggregated latency of the calls made to a single plugin topic
+     */
+    struct PluginCallStatistics
+    {
+        size_t calls = 0;
+        size_t failures = 0;
+        double total_s = 0.0;
+        double max_s = 0.0;
+    };
+
+    /**
+     * \brief Record of the work done during one planning cycle
+     */
+    struct PlanningCycleRecord
+    {
+        uint64_t cycle = 0;
+        size_t tree_depth = 0;
+        std::vector<size_t> open_list_sizes;
+        std::map<std::string, PluginCallStatistics> plugin_calls;
+        double cost_function_s = 0.0;
+        double total_s = 0.0;
+        size_t plan_size = 0;
+        std::map<std::string, double> plan_cost_terms;
+        std::vector<TraceEvent> events;
+    };
+
+    /**
+     * \brief Collects timing and search statistics for the arbitrator's 
+     *      planning cycles
+     * 
+     * Components of the planner report into the tracer as they work, and the
+     * completed record of the most recent cycle can be retrieved afterwards. 
+     * If an output file is configured each cycle is also appended to it as
+     * Chrome trace events, viewable with chrome://tracing or Perfetto.
+     * 
+     * All methods are thread safe.
+     */
+    class PlanningTracer
+    {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * \brief Constructor for PlanningTracer
+             * \param trace_file_path Path of the Chrome trace JSON file to write. If 
+             *      empty, no file is written.
+             */
+            PlanningTracer(const std::string &trace_file_path = "");
+
+            /**
+             * \brief Mark the start of a new planning cycle, discarding any in-progress record
+             */
+            void begin_cycle();
+
+            /**
+             * \brief Mark the completion of the current planning cycle
+             * \param plan_size The number of maneuvers in the resulting plan
+             */
+            void end_cycle(size_t plan_size);
+
+            /**
+             * \brief Record that a new depth of the search tree is being expanded
+             * \param open_list_size The number of plans in the open list at this depth
+             */
+            void record_search_level(size_t open_list_size);
+
+            /**
+             * \brief Record a service call made to a plugin
+             * \param topic The topic of the plugin's service
+             * \param start The time the call was made
+             * \param end The time the call returned
+             * \param success Whether the call succeeded
+             */
+            void record_plugin_call(const std::string &topic, Clock::time_point start, Clock::time_point end, bool success);
+
+            /**
+             * \brief Record an evaluation of the cost function
+             * \param start The time evaluation began
+             * \param end The time evaluation completed
+             */
+            void record_cost_evaluation(Clock::time_point start, Clock::time_point end);
+
+            /**
+             * \brief Record the cost breakdown of the plan selected in this cycle
+             * \param cost_terms A map of cost term name -> cost contributed by that term
+             */
+            void record_plan_cost(const std::map<std::string, double> &cost_terms);
+
+            /**
+             * \brief Get the record of the most recently completed planning cycle
+             */
+            PlanningCycleRecord get_last_cycle() const;
+
+        private:
+            double to_trace_us(Clock::time_point t) const;
+            int get_thread_index();
+            void write_trace(const PlanningCycleRecord &record);
+
+            mutable std::mutex mutex_;
+            Clock::time_point epoch_;
+            Clock::time_point cycle_start_;
+            uint64_t cycle_count_;
+            PlanningCycleRecord current_;
+            PlanningCycleRecord last_;
+            std::map<std::thread::id, int> thread_indices_;
+            std::ofstream trace_file_;
+    };
+};
+
+#endif //__ARBITRATOR_INCLUDE_PLANNING_TRACER_HPP__
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __ARBITRATOR_INCLUDE_SYNTHETIC_NEIGHBOR_GENERATOR_HPP__
+#define __ARBITRATOR_INCLUDE_SYNTHETIC_NEIGHBOR_GENERATOR_HPP__
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include <ros/ros.h>
+#include <cav_msgs/ManeuverPlan.h>
+#include "neighbor_generator.hpp"
+
+namespace arbitrator
+{
+    /**
+     * \brief Behavior of a single simulated strategic planning plugin
+     */
+    struct SyntheticPluginConfig
+    {
+        std::string name;
+        // Time the plugin takes to respond to each request
+        ros::Duration latency;
+        // Number of alternative plans the plugin responds with per request
+        int branching_factor = 1;
+        // Range of durations in seconds of the maneuvers the plugin plans
+        double min_maneuver_duration = 2.0;
+        double max_maneuver_duration = 5.0;
+        // Range of speeds in m/s of the maneuvers the plugin plans
+        double min_speed = 10.0;
+        double max_speed = 15.0;
+    };
+
+    /**
+     * \brief Implementation of the NeighborGenerator interface using simulated
+     *      in-process plugins
+     * 
+     * Allows the planning components to be exercised and benchmarked without
+     * ROS services or real plugins. Each simulated plugin appends lane following
+     * maneuvers of randomized duration and speed to the plan it is given, after
+     * blocking for its configured latency.
+     */
+    class SyntheticNeighborGenerator : public NeighborGenerator
+    {
+        public:
+            /**
+             * \brief Constructor for SyntheticNeighborGenerator
+             * \param plugins The simulated plugins to query for each expansion
+             * \param seed The seed for the random number generator, for repeatable runs
+             */
+            SyntheticNeighborGenerator(const std::vector<SyntheticPluginConfig> &plugins, unsigned int seed = 0) :
+                plugins_(plugins),
+                rng_(seed),
+                call_count_(0) {};
+
+            /**
+             * \brief Generate the responses of every simulated plugin to the given plan
+             * \param plan The plan that is the current search state
+             * \return A list of subsequent plans building on top of the input plan
+             */
+            std::vector<cav_msgs::ManeuverPlan> generate_neighbors(cav_msgs::ManeuverPlan plan) const;
+
+            /**
+             * \brief Get the number of simulated plugin requests made so far
+             */
+            size_t get_call_count() const;
+
+            /**
+             * \brief Reset the simulated plugin request count to zero
+             */
+            void reset_call_count();
+        private:
+            std::vector<SyntheticPluginConfig> plugins_;
+            mutable std::mt19937 rng_;
+            mutable std::mutex rng_mutex_;
+            mutable std::atomic<size_t> call_count_;
+    };
+};
+
+#endif //__ARBITRATOR_INCLUDE_SYNTHETIC_NEIGHBOR_GENERATOR_HPP__
@@ -23,6 +23,8 @@
 #include "cost_function.hpp"
 #include "neighbor_generator.hpp"
 #include "search_strategy.hpp"
+#include "planning_tracer.hpp"
+#include "worker_pool.hpp"
 
 namespace arbitrator
 {
@@ -44,26 +46,56 @@ namespace arbitrator
              * \param ng A reference to a NeighborGenerator implementation
              * \param ss A reference to a SearchStrategy implementation
              * \param target The desired duration of finished plans
+             * \param tracer An optional PlanningTracer to report search statistics to
+             * \param expansion_threads The maximum number of plans at one depth of the tree to
+             *      expand concurrently. The NeighborGenerator and CostFunction must be safe to 
+             *      call from multiple threads if this is greater than 1.
              */
             TreePlanner(const CostFunction &cf, 
                 const NeighborGenerator &ng, 
                 const SearchStrategy &ss, 
-                ros::Duration target):
+                ros::Duration target,
+                PlanningTracer *tracer = nullptr,
+                size_t expansion_threads = 1):
                 cost_function_(cf),
                 neighbor_generator_(ng),
                 search_strategy_(ss),
-                target_plan_duration_(target) {};
+                target_plan_duration_(target),
+                tracer_(tracer),
+                expansion_pool_(new WorkerPool(expansion_threads)) {};
 
             /**
              * \brief Utilize the configured cost function, neighbor generator, 
              *      and search strategy, to generate a plan by means of tree search
              */
             cav_msgs::ManeuverPlan generate_plan() const;
+
+            /**
+             * \brief Generate a plan by means of tree search, starting the
+             *      search from the provided plan instead of an empty root
+             * 
+             * Only the frontier beyond the seed plan is expanded, so plugins
+             * are not re-queried for the portion of the plan already agreed upon.
+             * 
+             * \param seed The plan to use as the root of the search tree
+             * \param planning_start The time from which the duration of candidate plans is measured
+             */
+            cav_msgs::ManeuverPlan generate_plan(const cav_msgs::ManeuverPlan &seed, ros::Time planning_start) const;
         protected:
+            /**
+             * \brief Perform the tree search rooted at the seed plan
+             * \param seed The plan to use as the root of the search tree
+             * \param planning_start The time from which the duration of candidate plans is measured
+             */
+            cav_msgs::ManeuverPlan search(const cav_msgs::ManeuverPlan &seed, ros::Time planning_start) const;
+
             const CostFunction &cost_function_;
             const NeighborGenerator &neighbor_generator_;
             const SearchStrategy &search_strategy_;
             ros::Duration target_plan_duration_;
+            PlanningTracer *tracer_;
+            // Threads are started once and shared by every search level
+            std::unique_ptr<WorkerPool> expansion_pool_;
     };
 };
 
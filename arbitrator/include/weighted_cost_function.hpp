@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __ARBITRATOR_INCLUDE_WEIGHTED_COST_FUNCTION_HPP__
+#define __ARBITRATOR_INCLUDE_WEIGHTED_COST_FUNCTION_HPP__
+
+#include "cost_function.hpp"
+#include "fixed_priority_cost_function.hpp"
+#include <map>
+#include <string>
+
+namespace arbitrator
+{
+    /**
+     * \brief Weights applied to each term of the WeightedCostFunction. A weight 
+     *      of zero removes the term from consideration.
+     */
+    struct CostWeights
+    {
+        double plugin_priority = 1.0;
+        double plan_duration = 0.0;
+        double speed_smoothness = 0.0;
+        double lane_changes = 0.0;
+        double distance_to_goal = 0.0;
+
+        /**
+         * \brief Build a set of weights from a parameter map, keyed by the field names
+         *      of this struct. Missing keys retain their default value.
+         * \param weights A map of term name -> weight
+         * \return The resulting CostWeights
+         * \throws std::invalid_argument if the map contains an unknown term name
+         */
+        static CostWeights from_map(const std::map<std::string, double> &weights);
+    };
+
+    /**
+     * \brief The individual weighted terms making up the total cost of a plan
+     */
+    struct CostBreakdown
+    {
+        double plugin_priority = 0.0;
+        double plan_duration = 0.0;
+        double speed_smoothness = 0.0;
+        double lane_changes = 0.0;
+        double distance_to_goal = 0.0;
+        double total = 0.0;
+    };
+
+    /**
+     * \brief Implementation of the CostFunction interface as a weighted sum of
+     *      several objectives
+     * 
+     * The terms considered are:
+     * plugin_priority - The FixedPriorityCostFunction cost of each maneuver
+     * plan_duration - The time in seconds covered by the plan
+     * speed_smoothness - The total change in speed in m/s over and between maneuvers
+     * lane_changes - The number of lane change maneuvers in the plan
+     * distance_to_goal - The distance in meters left between the end of the plan
+     *      and the end of the route, if a route end has been provided
+     * 
+     * All terms are computed in a single pass over the maneuvers of the plan.
+     */
+    class WeightedCostFunction : public CostFunction
+    {
+        public:
+            /**
+             * \brief Constructor for WeightedCostFunction
+             * \param priority_cost The cost function used to evaluate the plugin_priority term
+             * \param weights The weight applied to each term
+             * \param route_end_distance The downtrack distance in meters of the end of the route.
+             *      A negative value disables the distance_to_goal term.
+             */
+            WeightedCostFunction(const FixedPriorityCostFunction &priority_cost, 
+                CostWeights weights,
+                double route_end_distance = -1.0) :
+                priority_cost_(priority_cost),
+                weights_(weights),
+                route_end_distance_(route_end_distance) {};
+
+            /**
+             * \brief Compute the cost of a given maneuver plan
+             * \param plan The plan to evaluate
+             * \return double The total cost
+             */
+            double compute_total_cost(const cav_msgs::ManeuverPlan &plan) const;
+
+            /**
+             * \brief Compute the unit cost over distance of a given maneuver plan
+             * \param plan The plan to evaluate
+             * \return double The total cost divided by the total distance of the plan
+             */
+            double compute_cost_per_unit_distance(const cav_msgs::ManeuverPlan &plan) const;
+
+            /**
+             * \brief Compute the individual weighted terms of the cost of a plan
+             * \param plan The plan to evaluate
+             * \return The weighted value of each term and their total
+             */
+            CostBreakdown compute_cost_breakdown(const cav_msgs::ManeuverPlan &plan) const;
+
+            /**
+             * \brief Compute the cost breakdown of a plan keyed by term name
+             * \param plan The plan to evaluate
+             * \return A map of term name -> weighted cost of that term, including the total
+             */
+            std::map<std::string, double> compute_cost_terms(const cav_msgs::ManeuverPlan &plan) const;
+        private:
+            const FixedPriorityCostFunction &priority_cost_;
+            CostWeights weights_;
+            double route_end_distance_;
+    };
+};
+
+#endif //__ARBITRATOR_INCLUDE_WEIGHTED_COST_FUNCTION_HPP__
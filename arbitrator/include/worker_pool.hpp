@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __ARBITRATOR_INCLUDE_WORKER_POOL_HPP__
+#define __ARBITRATOR_INCLUDE_WORKER_POOL_HPP__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace arbitrator
+{
+    /**
+     * \brief Fixed set of threads executing indexed tasks on behalf of callers
+     * 
+     * The threads are started once at construction rather than for every batch
+     * of tasks. A caller always works on its own batch alongside the pool's
+     * threads, so batches may be submitted concurrently or from within a task
+     * of another batch without deadlocking.
+     */
+    class WorkerPool
+    {
+        public:
+            /**
+             * \brief Constructor for WorkerPool
+             * \param max_threads The number of threads, including the calling thread, which
+             *      may work on a batch. With 1 every task is run in order on the calling thread.
+             */
+            explicit WorkerPool(size_t max_threads);
+
+            /**
+             * \brief Stops and joins the pool's threads. No batch may be in progress.
+             */
+            ~WorkerPool();
+
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            /**
+             * \brief Execute a task for each index in [0, count), returning once all tasks have completed
+             * \param count The number of tasks to execute
+             * \param task The task to execute, invoked with the index of each task
+             * \throws The first exception thrown by any task, after all tasks have finished
+             */
+            void parallel_for(size_t count, const std::function<void(size_t)> &task);
+        private:
+            struct Batch;
+
+            /**
+             * \brief Run the next unclaimed task of a batch
+             * \return False if every task of the batch had already been claimed
+             */
+            static bool run_next_task(Batch &batch);
+
+            /**
+             * \brief Loop executed by each of the pool's threads until the pool is destroyed
+             */
+            void worker_loop();
+
+            /**
+             * \brief Remove a batch from the queue of batches with unclaimed tasks, if still present.
+             *      Must be called with queue_mutex_ held.
+             */
+            void remove_batch(const std::shared_ptr<Batch> &batch);
+
+            std::vector<std::thread> workers_;
+            std::deque<std::shared_ptr<Batch>> queue_;
+            std::mutex queue_mutex_;
+            std::condition_variable work_available_;
+            bool stopping_ = false;
+    };
+};
+
+#endif //__ARBITRATOR_INCLUDE_WORKER_POOL_HPP__
@@ -19,38 +19,51 @@
 #include <cav_srvs/PlanManeuvers.h>
 #include "arbitrator_utils.hpp"
 #include <ros/ros.h>
+#include <diagnostic_msgs/DiagnosticArray.h>
 #include <exception>
 #include <cstdlib>
+#include <sstream>
 
 namespace arbitrator
 {
     void Arbitrator::run()
     {
         ROS_INFO("Aribtrator started, beginning arbitrator state machine.");
-        while (!ros::isShuttingDown())
+        initial_state();
+
+        // All further processing happens in the guidance state and planning timer callbacks
+        ros::spin();
+    }
+
+    void Arbitrator::handle_event(ArbitratorEvent event)
+    {
+        ArbitratorState prior_state = sm_->get_state();
+        ArbitratorState new_state = sm_->submit_event(event);
+        if (new_state == prior_state) 
         {
-            ros::spinOnce();
-            switch (sm_->get_state()) 
-            {
-                case INITIAL:
-                    ROS_INFO("Aribtrator spinning in INITIAL state.");
-                    initial_state();
-                    break;
-                case PLANNING:
-                    ROS_INFO("Aribtrator spinning in PLANNING state.");
-                    planning_state();
-                    break;
-                case WAITING:
-                    ROS_INFO("Aribtrator spinning in WAITING state.");
-                    waiting_state();
-                    break;
-                case PAUSED:
-                    ROS_INFO("Aribtrator spinning in PAUSED state.");
-                    paused_state();
-                    break;
-                default:
-                    throw std::invalid_argument("State machine attempting to process an illegal state value");
-            }
+            return;
+        }
+
+        switch (new_state) 
+        {
+            case PLANNING:
+                ROS_INFO("Aribtrator entering PLANNING state.");
+                planning_state();
+                break;
+            case WAITING:
+                ROS_INFO("Aribtrator entering WAITING state.");
+                waiting_state();
+                break;
+            case PAUSED:
+                ROS_INFO("Aribtrator entering PAUSED state.");
+                paused_state();
+                break;
+            case SHUTDOWN:
+                ROS_INFO("Aribtrator entering SHUTDOWN state.");
+                shutdown_state();
+                break;
+            default:
+                throw std::invalid_argument("State machine attempting to process an illegal state value");
         }
     }
     
@@ -70,18 +83,18 @@ namespace arbitrator
             case cav_msgs::GuidanceState::ENGAGED:
                 ROS_INFO("Received notiace that guidance has been engaged!");
                 if (sm_->get_state() == ArbitratorState::INITIAL) {
-                    sm_->submit_event(ArbitratorEvent::SYSTEM_STARTUP_COMPLETE);
+                    handle_event(ArbitratorEvent::SYSTEM_STARTUP_COMPLETE);
                 } else if (sm_->get_state() == ArbitratorState::PAUSED) {
-                    sm_->submit_event(ArbitratorEvent::ARBITRATOR_RESUMED);
+                    handle_event(ArbitratorEvent::ARBITRATOR_RESUMED);
                 }
                 break;
             case cav_msgs::GuidanceState::INACTIVE:
                 ROS_INFO("Received notiace that guidance has been disengaged, pausing arbitrator.");
-                sm_->submit_event(ArbitratorEvent::ARBITRATOR_PAUSED);
+                handle_event(ArbitratorEvent::ARBITRATOR_PAUSED);
                 break;
             case cav_msgs::GuidanceState::SHUTDOWN:
                 ROS_INFO("Received notiace that guidance has been shutdown, shutting down arbitrator.");
-                sm_->submit_event(ArbitratorEvent::SYSTEM_SHUTDOWN_INITIATED);
+                handle_event(ArbitratorEvent::SYSTEM_SHUTDOWN_INITIATED);
                 break;
             default:
                 break;
@@ -95,6 +108,10 @@ namespace arbitrator
             ROS_INFO("Arbitrator initializing on first initial state spin...");
             final_plan_pub_ = nh_->advertise<cav_msgs::ManeuverPlan>("final_maneuver_plan", 5);
             guidance_state_sub_ = nh_->subscribe<cav_msgs::GuidanceState>("guidance_state", 5, &Arbitrator::guidance_state_cb, this);
+            if (tracer_ != nullptr)
+            {
+                diagnostics_pub_ = nh_->advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 5);
+            }
             initialized_ = true;
             // TODO: load plan duration from parameters file
         }
@@ -104,12 +121,24 @@ namespace arbitrator
     {
         ROS_INFO("Aribtrator beginning planning process!");
         ros::Time planning_process_start = ros::Time::now();
-        cav_msgs::ManeuverPlan plan = planning_strategy_.generate_plan();
+
+        cav_msgs::ManeuverPlan plan;
+        if (warm_start_ && !latest_plan_.maneuvers.empty())
+        {
+            // Resume from the portion of the last plan still in effect and only extend beyond it
+            cav_msgs::ManeuverPlan seed = arbitrator_utils::get_unexpired_plan(latest_plan_, planning_process_start);
+            ROS_DEBUG_STREAM("Arbitrator warm starting from " << seed.maneuvers.size() << " unexpired maneuvers of plan " << latest_plan_.maneuver_plan_id);
+            plan = planning_strategy_.generate_plan(seed, planning_process_start);
+        }
+        else
+        {
+            plan = planning_strategy_.generate_plan();
+        }
+
         if (!plan.maneuvers.empty()) 
         {
-            ros::Time plan_end_time = arbitrator_utils::get_plan_end_time(plan);
-            ros::Time plan_start_time = arbitrator_utils::get_plan_start_time(plan);
-            ros::Duration plan_duration = plan_end_time - plan_start_time;
+            // A warm started plan may begin with a maneuver already in progress, only its remainder counts
+            ros::Duration plan_duration = arbitrator_utils::get_plan_remaining_duration(plan, planning_process_start);
 
             if (plan_duration < min_plan_duration_) 
             {
@@ -120,32 +149,99 @@ namespace arbitrator
                 ROS_INFO_STREAM("Arbitrator is publishing plan " << plan.maneuver_plan_id << " of duration " << plan_duration << " as current maneuver plan");
             }
             final_plan_pub_.publish(plan);
+            latest_plan_ = plan;
         }
         else
         {
             ROS_WARN("Arbitrator was unable to generate a plan!");
         }
 
+        if (tracer_ != nullptr)
+        {
+            publish_planning_diagnostics();
+        }
+
         next_planning_process_start_ = planning_process_start + time_between_plans_;
 
-        sm_->submit_event(ArbitratorEvent::PLANNING_COMPLETE);
+        handle_event(ArbitratorEvent::PLANNING_COMPLETE);
+    }
+
+    void Arbitrator::publish_planning_diagnostics()
+    {
+        PlanningCycleRecord record = tracer_->get_last_cycle();
+
+        diagnostic_msgs::DiagnosticStatus status;
+        status.level = diagnostic_msgs::DiagnosticStatus::OK;
+        status.name = "arbitrator: planning";
+        status.hardware_id = "arbitrator";
+        status.message = "Planning cycle " + std::to_string(record.cycle);
+
+        auto add_value = [&status](const std::string &key, const std::string &value)
+        {
+            diagnostic_msgs::KeyValue kv;
+            kv.key = key;
+            kv.value = value;
+            status.values.push_back(kv);
+        };
+
+        std::ostringstream open_list_sizes;
+        for (auto it = record.open_list_sizes.begin(); it != record.open_list_sizes.end(); it++)
+        {
+            open_list_sizes << (it == record.open_list_sizes.begin() ? "" : ",") << *it;
+        }
+
+        add_value("tree_depth", std::to_string(record.tree_depth));
+        add_value("open_list_sizes", open_list_sizes.str());
+        add_value("plan_size", std::to_string(record.plan_size));
+        add_value("cost_function_time_s", std::to_string(record.cost_function_s));
+        add_value("total_time_s", std::to_string(record.total_s));
+        for (auto it = record.plugin_calls.begin(); it != record.plugin_calls.end(); it++)
+        {
+            std::ostringstream latency;
+            latency << "calls=" << it->second.calls 
+                << " failures=" << it->second.failures
+                << " mean_s=" << it->second.total_s / it->second.calls
+                << " max_s=" << it->second.max_s;
+            add_value("plugin_latency " + it->first, latency.str());
+        }
+        for (auto it = record.plan_cost_terms.begin(); it != record.plan_cost_terms.end(); it++)
+        {
+            add_value("plan_cost " + it->first, std::to_string(it->second));
+        }
+
+        diagnostic_msgs::DiagnosticArray msg;
+        msg.header.stamp = ros::Time::now();
+        msg.status.push_back(status);
+        diagnostics_pub_.publish(msg);
+    }
+
+    void Arbitrator::planning_timer_cb(const ros::TimerEvent& te)
+    {
+        if (sm_->get_state() == ArbitratorState::WAITING)
+        {
+            ROS_INFO("Arbitrator transitioning from WAITING to PLANNING state.");
+            handle_event(ArbitratorEvent::PLANNING_TIMER_TRIGGER);
+        }
     }
 
     void Arbitrator::waiting_state()
     {
-        // Sleep in 100ms increments until our next planning cycle
-        // This ensures we spin() at least a few times
-        while (ros::Time::now() < next_planning_process_start_)
+        // Schedule the next planning cycle relative to the start of the last one
+        ros::Duration time_until_next_plan = next_planning_process_start_ - ros::Time::now();
+        if (time_until_next_plan < ros::Duration(0))
         {
-            ros::Duration(0.1).sleep();
+            ROS_WARN_STREAM("Arbitrator planning overran its cycle by " << -time_until_next_plan.toSec() << "s");
+            time_until_next_plan = ros::Duration(0);
         }
-        ROS_INFO("Arbitrator transitioning from WAITING to PLANNING state.");
-        sm_->submit_event(ArbitratorEvent::PLANNING_TIMER_TRIGGER);
+        planning_timer_ = nh_->createTimer(time_until_next_plan, &Arbitrator::planning_timer_cb, this, true);
     }
 
     void Arbitrator::paused_state()
     {
-        ros::Duration(0.1).sleep();
+        planning_timer_.stop();
+
+        // Any plan from before the pause can no longer be assumed to be in effect
+        latest_plan_ = cav_msgs::ManeuverPlan();
     }
 
     void Arbitrator::shutdown_state()
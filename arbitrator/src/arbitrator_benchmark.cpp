@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <ros/ros.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "arbitrator_utils.hpp"
+#include "beam_search_strategy.hpp"
+#include "fixed_priority_cost_function.hpp"
+#include "planning_tracer.hpp"
+#include "synthetic_neighbor_generator.hpp"
+#include "tree_planner.hpp"
+
+/**
+ * Offline benchmark for the arbitrator planning components
+ * 
+ * Runs TreePlanner with BeamSearchStrategy and FixedPriorityCostFunction against
+ * simulated in-process plugins for each requested beam width and reports planning
+ * throughput and the quality of the resulting plans. No ROS master or plugin
+ * services are needed.
+ * 
+ * Usage: arbitrator_benchmark [--plugins N] [--branching N] [--latency-ms MS]
+ *      [--min-duration S] [--max-duration S] [--target-duration S] 
+ *      [--beam-widths W1,W2,...] [--cycles N] [--seed N]
+ * 
+ * A beam width of "bfs" runs an unbounded (breadth-first) search.
+ */
+
+namespace
+{
+    void print_usage()
+    {
+        std::cerr << "Usage: arbitrator_benchmark [--plugins N] [--branching N] [--latency-ms MS] "
+            << "[--min-duration S] [--max-duration S] [--target-duration S] "
+            << "[--beam-widths W1,W2,...] [--cycles N] [--seed N]" << std::endl;
+    }
+
+    std::vector<int> parse_beam_widths(const std::string &arg)
+    {
+        std::vector<int> out;
+        std::stringstream ss(arg);
+        std::string token;
+        while (std::getline(ss, token, ','))
+        {
+            out.push_back(token == "bfs" ? std::numeric_limits<int>::max() : std::stoi(token));
+        }
+        return out;
+    }
+
+    std::string strategy_name(int beam_width)
+    {
+        if (beam_width == 1) 
+        {
+            return "greedy";
+        }
+        if (beam_width == std::numeric_limits<int>::max())
+        {
+            return "breadth-first";
+        }
+        return "beam(" + std::to_string(beam_width) + ")";
+    }
+}
+
+int main(int argc, char** argv) 
+{
+    ros::Time::init();
+
+    int num_plugins = 3;
+    int branching_factor = 1;
+    double latency_ms = 2.0;
+    double min_duration = 2.0;
+    double max_duration = 5.0;
+    double target_duration = 15.0;
+    std::vector<int> beam_widths = {1, 2, 3, 5};
+    int cycles = 10;
+    unsigned int seed = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            print_usage();
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--plugins") num_plugins = std::stoi(value);
+        else if (arg == "--branching") branching_factor = std::stoi(value);
+        else if (arg == "--latency-ms") latency_ms = std::stod(value);
+        else if (arg == "--min-duration") min_duration = std::stod(value);
+        else if (arg == "--max-duration") max_duration = std::stod(value);
+        else if (arg == "--target-duration") target_duration = std::stod(value);
+        else if (arg == "--beam-widths") beam_widths = parse_beam_widths(value);
+        else if (arg == "--cycles") cycles = std::stoi(value);
+        else if (arg == "--seed") seed = static_cast<unsigned int>(std::stoul(value));
+        else 
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    // Plugins are given descending priorities so the cost function has something to choose between
+    std::vector<arbitrator::SyntheticPluginConfig> plugins;
+    std::map<std::string, double> plugin_priorities;
+    for (int i = 0; i < num_plugins; i++)
+    {
+        arbitrator::SyntheticPluginConfig plugin;
+        plugin.name = "synthetic_plugin_" + std::to_string(i);
+        plugin.latency = ros::Duration(latency_ms / 1000.0);
+        plugin.branching_factor = branching_factor;
+        plugin.min_maneuver_duration = min_duration;
+        plugin.max_maneuver_duration = max_duration;
+        plugins.push_back(plugin);
+        plugin_priorities[plugin.name] = static_cast<double>(num_plugins - i);
+    }
+
+    arbitrator::FixedPriorityCostFunction fpcf{plugin_priorities};
+
+    std::cout << std::left 
+        << std::setw(16) << "strategy" 
+        << std::setw(12) << "plans/s" 
+        << std::setw(14) << "mean_ms" 
+        << std::setw(14) << "calls/plan" 
+        << std::setw(12) << "depth" 
+        << std::setw(14) << "duration_s" 
+        << std::setw(12) << "reached" 
+        << std::setw(12) << "cost/m" << std::endl;
+
+    for (auto width = beam_widths.begin(); width != beam_widths.end(); width++)
+    {
+        arbitrator::SyntheticNeighborGenerator sng{plugins, seed};
+        arbitrator::BeamSearchStrategy bss{*width};
+        arbitrator::PlanningTracer tracer;
+        arbitrator::TreePlanner tp{fpcf, sng, bss, ros::Duration(target_duration), &tracer};
+
+        double total_depth = 0.0;
+        double total_plan_duration = 0.0;
+        double total_cost = 0.0;
+        int targets_reached = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int c = 0; c < cycles; c++)
+        {
+            cav_msgs::ManeuverPlan plan = tp.generate_plan();
+            total_depth += tracer.get_last_cycle().tree_depth;
+            if (!plan.maneuvers.empty())
+            {
+                double duration = (arbitrator_utils::get_plan_end_time(plan) - arbitrator_utils::get_plan_start_time(plan)).toSec();
+                total_plan_duration += duration;
+                total_cost += fpcf.compute_cost_per_unit_distance(plan);
+                targets_reached += duration >= target_duration ? 1 : 0;
+            }
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::left << std::fixed << std::setprecision(3)
+            << std::setw(16) << strategy_name(*width)
+            << std::setw(12) << cycles / elapsed
+            << std::setw(14) << 1000.0 * elapsed / cycles
+            << std::setw(14) << static_cast<double>(sng.get_call_count()) / cycles
+            << std::setw(12) << total_depth / cycles
+            << std::setw(14) << total_plan_duration / cycles
+            << std::setw(12) << static_cast<double>(targets_reached) / cycles
+            << std::setw(12) << total_cost / cycles << std::endl;
+    }
+
+    return 0;
+}
@@ -15,14 +15,18 @@
 
 #include <ros/ros.h>
 #include <memory>
+#include <algorithm>
 #include <map>
 #include <string>
 #include "arbitrator.hpp"
 #include "arbitrator_state_machine.hpp"
 #include "fixed_priority_cost_function.hpp"
+#include "weighted_cost_function.hpp"
 #include "plugin_neighbor_generator.hpp"
+#include "caching_neighbor_generator.hpp"
 #include "beam_search_strategy.hpp"
 #include "tree_planner.hpp"
+#include "planning_tracer.hpp"
 
 int main(int argc, char** argv) 
 {
@@ -31,28 +35,62 @@ int main(int argc, char** argv)
     ros::CARMANodeHandle pnh = ros::CARMANodeHandle("~");
 
     // Handle dependency injection
-    arbitrator::CapabilitiesInterface ci{&nh};
+    bool enable_planning_trace;
+    pnh.param("enable_planning_trace", enable_planning_trace, false);
+    std::string planning_trace_file;
+    pnh.param<std::string>("planning_trace_file", planning_trace_file, "");
+    std::unique_ptr<arbitrator::PlanningTracer> tracer;
+    if (enable_planning_trace)
+    {
+        tracer.reset(new arbitrator::PlanningTracer(planning_trace_file));
+    }
+
+    int plugin_call_threads;
+    pnh.param("plugin_call_threads", plugin_call_threads, 1);
+    arbitrator::CapabilitiesInterface ci{&nh, tracer.get(), static_cast<size_t>(std::max(plugin_call_threads, 1))};
     arbitrator::ArbitratorStateMachine sm;
 
     std::map<std::string, double> plugin_priorities;
     pnh.getParam("plugin_priorities", plugin_priorities);
     arbitrator::FixedPriorityCostFunction fpcf{plugin_priorities};
 
+    std::map<std::string, double> cost_weights;
+    pnh.getParam("cost_weights", cost_weights);
+    double route_end_distance;
+    pnh.param("route_end_distance", route_end_distance, -1.0);
+    arbitrator::WeightedCostFunction wcf{fpcf, arbitrator::CostWeights::from_map(cost_weights), route_end_distance};
+
+    std::string cost_function_name;
+    pnh.param<std::string>("cost_function", cost_function_name, "fixed_priority");
+    const arbitrator::CostFunction &cf = (cost_function_name == "weighted") ? 
+        static_cast<const arbitrator::CostFunction&>(wcf) : 
+        static_cast<const arbitrator::CostFunction&>(fpcf);
+
     int beam_width;
     pnh.param("beam_width", beam_width, 3);
     arbitrator::BeamSearchStrategy bss{beam_width};
 
     arbitrator::PluginNeighborGenerator<arbitrator::CapabilitiesInterface> png{ci};
 
+    double plugin_response_cache_ttl;
+    pnh.param("plugin_response_cache_ttl", plugin_response_cache_ttl, 0.0);
+    arbitrator::CachingNeighborGenerator cng{png, ros::Duration(plugin_response_cache_ttl)};
+
     double target_plan;
     pnh.param("target_duration", target_plan, 15.0);
-    arbitrator::TreePlanner tp{fpcf, png, bss, ros::Duration(target_plan)};
+    int expansion_threads;
+    pnh.param("expansion_threads", expansion_threads, 1);
+    arbitrator::TreePlanner tp{cf, cng, bss, ros::Duration(target_plan), tracer.get(), 
+        static_cast<size_t>(std::max(expansion_threads, 1))};
 
     double min_plan_duration;
     pnh.param("min_plan_duration", min_plan_duration, 6.0);
 
     double planning_frequency;
     pnh.param("planning_frequency", planning_frequency, 1.0);
+
+    bool use_warm_start;
+    pnh.param("use_warm_start", use_warm_start, false);
     arbitrator::Arbitrator arbitrator{
         &nh, 
         &pnh, 
@@ -60,7 +98,9 @@ int main(int argc, char** argv)
         &ci, 
         tp, 
         ros::Duration(min_plan_duration),
-        ros::Rate(planning_frequency)};
+        ros::Rate(planning_frequency),
+        use_warm_start,
+        tracer.get()};
 
     arbitrator.run();
 
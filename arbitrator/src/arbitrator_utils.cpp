@@ -66,6 +66,12 @@ namespace arbitrator_utils
         return get_maneuver_start_distance(m);
     }
 
+    ros::Duration get_plan_remaining_duration(const cav_msgs::ManeuverPlan &plan, ros::Time from)
+    {
+        ros::Time start_time = get_plan_start_time(plan);
+        return get_plan_end_time(plan) - std::max(start_time, from);
+    }
+
     ros::Time get_maneuver_end_time(const cav_msgs::Maneuver &mvr) 
     {
         return GET_MANEUVER_PROPERTY(mvr, end_time);
@@ -85,4 +91,51 @@ namespace arbitrator_utils
     {
         return GET_MANEUVER_PROPERTY(mvr, start_dist);
     }
+
+    /**
+     * \brief Copy the shared fields out of a specific maneuver type
+     */
+    template <typename M>
+    static ManeuverProperties extract_properties(const M &mvr)
+    {
+        return ManeuverProperties{&mvr.parameters, 
+            mvr.start_time, mvr.end_time, 
+            mvr.start_dist, mvr.end_dist, 
+            mvr.start_speed, mvr.end_speed};
+    }
+
+    ManeuverProperties get_maneuver_properties(const cav_msgs::Maneuver &mvr)
+    {
+        switch (mvr.type)
+        {
+            case cav_msgs::Maneuver::INTERSECTION_TRANSIT_LEFT_TURN:
+                return extract_properties(mvr.intersection_transit_left_turn_maneuver);
+            case cav_msgs::Maneuver::INTERSECTION_TRANSIT_RIGHT_TURN:
+                return extract_properties(mvr.intersection_transit_right_turn_maneuver);
+            case cav_msgs::Maneuver::INTERSECTION_TRANSIT_STRAIGHT:
+                return extract_properties(mvr.intersection_transit_straight_maneuver);
+            case cav_msgs::Maneuver::LANE_CHANGE:
+                return extract_properties(mvr.lane_change_maneuver);
+            case cav_msgs::Maneuver::LANE_FOLLOWING:
+                return extract_properties(mvr.lane_following_maneuver);
+            default:
+                throw std::invalid_argument("get_maneuver_properties called on maneuver with invalid type id");
+        }
+    }
+
+    cav_msgs::ManeuverPlan get_unexpired_plan(const cav_msgs::ManeuverPlan &plan, ros::Time current_time)
+    {
+        cav_msgs::ManeuverPlan out(plan);
+        out.maneuvers.clear();
+
+        for (auto it = plan.maneuvers.begin(); it != plan.maneuvers.end(); it++)
+        {
+            if (get_maneuver_end_time(*it) > current_time)
+            {
+                out.maneuvers.push_back(*it);
+            }
+        }
+
+        return out;
+    }
 } // namespace arbitrator_utils
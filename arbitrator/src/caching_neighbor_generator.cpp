@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "caching_neighbor_generator.hpp"
+#include "arbitrator_utils.hpp"
+#include <iomanip>
+#include <sstream>
+
+namespace arbitrator
+{
+    std::string CachingNeighborGenerator::compute_key(const cav_msgs::ManeuverPlan &plan)
+    {
+        std::ostringstream key;
+        // Distances and speeds are written at full precision so maneuvers far along the route still get distinct keys
+        key << std::setprecision(17);
+        for (auto it = plan.maneuvers.begin(); it != plan.maneuvers.end(); it++)
+        {
+            const cav_msgs::ManeuverParameters &params = GET_MANEUVER_PROPERTY(*it, parameters);
+            key << static_cast<int>(it->type) << ":"
+                << params.maneuver_id << ":"
+                << params.planning_strategic_plugin << ":"
+                << arbitrator_utils::get_maneuver_start_time(*it).toNSec() << ":"
+                << arbitrator_utils::get_maneuver_end_time(*it).toNSec() << ":"
+                << arbitrator_utils::get_maneuver_start_distance(*it) << ":"
+                << arbitrator_utils::get_maneuver_end_distance(*it) << ":"
+                << GET_MANEUVER_PROPERTY(*it, start_speed) << ":"
+                << GET_MANEUVER_PROPERTY(*it, end_speed) << ";";
+        }
+
+        return key.str();
+    }
+
+    std::vector<cav_msgs::ManeuverPlan> CachingNeighborGenerator::generate_neighbors(cav_msgs::ManeuverPlan plan) const
+    {
+        // Plugins plan the root of the search from the current vehicle state, which the key does not capture
+        if (ttl_ <= ros::Duration(0) || plan.maneuvers.empty())
+        {
+            return neighbor_generator_.generate_neighbors(plan);
+        }
+
+        ros::Time now = ros::Time::now();
+        std::string key = compute_key(plan);
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+
+            // Evict stale responses before consulting the cache
+            for (auto it = cache_.begin(); it != cache_.end();)
+            {
+                if (now - it->second.stored_at > ttl_)
+                {
+                    it = cache_.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+
+            auto cached = cache_.find(key);
+            if (cached != cache_.end())
+            {
+                ROS_DEBUG_STREAM("Reusing " << cached->second.neighbors.size() << " cached plugin responses for plan prefix of " 
+                    << plan.maneuvers.size() << " maneuvers");
+                return cached->second.neighbors;
+            }
+        }
+
+        // The lock is not held while querying so concurrent expansions are not serialized
+        std::vector<cav_msgs::ManeuverPlan> neighbors = neighbor_generator_.generate_neighbors(plan);
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        cache_[key] = CacheEntry{now, neighbors};
+        return neighbors;
+    }
+}
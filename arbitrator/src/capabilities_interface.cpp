@@ -33,6 +33,8 @@ namespace arbitrator
 
         if (query_string == STRATEGIC_PLAN_CAPABILITY)
         {
+            // Parallel beam expansion may query the plugin list from several threads
+            std::lock_guard<std::mutex> lock(sc_s_mutex_);
             if (sc_s.call(srv))
             {
                 topics = srv.response.plan_service;
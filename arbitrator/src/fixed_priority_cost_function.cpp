@@ -33,29 +33,87 @@ namespace arbitrator
             }
         }
 
-        // Normalize the list and invert into costs
+        // Normalize the list, invert into costs, and intern each plugin name
+        plugin_costs_.reserve(plugin_priorities.size());
         for (auto it = plugin_priorities.begin(); it != plugin_priorities.end(); it++)
         {
-            plugin_costs_[it->first] = 1.0 - (it->second / max_priority);
+            plugin_ids_[it->first] = plugin_costs_.size();
+            plugin_costs_.push_back(1.0 - (it->second / max_priority));
         }
     }
 
-    double FixedPriorityCostFunction::compute_total_cost(cav_msgs::ManeuverPlan plan) const
+    double FixedPriorityCostFunction::get_plugin_cost(const std::string &planning_plugin) const
+    {
+        return plugin_costs_[plugin_ids_.at(planning_plugin)];
+    }
+
+    double FixedPriorityCostFunction::compute_maneuver_cost(const cav_msgs::Maneuver &mvr) const
+    {
+        arbitrator_utils::ManeuverProperties props = arbitrator_utils::get_maneuver_properties(mvr);
+        return (props.end_dist - props.start_dist) * get_plugin_cost(props.parameters->planning_strategic_plugin);
+    }
+
+    double FixedPriorityCostFunction::compute_maneuvers_cost(const cav_msgs::ManeuverPlan &plan, size_t first) const
     {
         double total_cost = 0.0;
-        for (auto it = plan.maneuvers.begin(); it != plan.maneuvers.end(); it++)
+        for (size_t i = first; i < plan.maneuvers.size(); i++)
         {
-            std::string planning_plugin = GET_MANEUVER_PROPERTY(*it, parameters).planning_strategic_plugin;
-            total_cost += (arbitrator_utils::get_maneuver_end_distance(*it) - arbitrator_utils::get_maneuver_start_distance(*it)) *
-                plugin_costs_.at(planning_plugin);
+            total_cost += compute_maneuver_cost(plan.maneuvers[i]);
         }
 
         return total_cost;
     }
 
-    double FixedPriorityCostFunction::compute_cost_per_unit_distance(cav_msgs::ManeuverPlan plan) const
+    bool FixedPriorityCostFunction::has_cost_prefix(const cav_msgs::ManeuverPlan &plan, const cav_msgs::ManeuverPlan &prefix) const
+    {
+        if (plan.maneuvers.size() < prefix.maneuvers.size())
+        {
+            return false;
+        }
+
+        // Plugins assign a new id to any maneuver they replan, so unchanged ids mean unchanged costs.
+        // Maneuvers without an id cannot be identified and are always evaluated again.
+        for (size_t i = 0; i < prefix.maneuvers.size(); i++)
+        {
+            const std::string &prefix_id = GET_MANEUVER_PROPERTY(prefix.maneuvers[i], parameters.maneuver_id);
+            if (prefix_id.empty() || prefix_id != GET_MANEUVER_PROPERTY(plan.maneuvers[i], parameters.maneuver_id))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    double FixedPriorityCostFunction::compute_total_cost(const cav_msgs::ManeuverPlan &plan) const
+    {
+        return compute_maneuvers_cost(plan, 0);
+    }
+
+    double FixedPriorityCostFunction::compute_cost_per_unit_distance(const cav_msgs::ManeuverPlan &plan) const
     {
         double plan_dist = arbitrator_utils::get_plan_end_distance(plan) - arbitrator_utils::get_plan_start_distance(plan);
         return compute_total_cost(plan) / plan_dist;
     }
+
+    std::vector<double> FixedPriorityCostFunction::compute_costs_per_unit_distance(const cav_msgs::ManeuverPlan &parent, 
+        const std::vector<cav_msgs::ManeuverPlan> &children) const
+    {
+        double parent_cost = compute_total_cost(parent);
+        size_t parent_size = parent.maneuvers.size();
+
+        std::vector<double> costs;
+        costs.reserve(children.size());
+        for (auto it = children.begin(); it != children.end(); it++)
+        {
+            // Plugins usually build on the prior plan, so only the maneuvers appended beyond the parent need evaluation
+            double total_cost = has_cost_prefix(*it, parent) ? 
+                parent_cost + compute_maneuvers_cost(*it, parent_size) : 
+                compute_total_cost(*it);
+            double plan_dist = arbitrator_utils::get_plan_end_distance(*it) - arbitrator_utils::get_plan_start_distance(*it);
+            costs.push_back(total_cost / plan_dist);
+        }
+
+        return costs;
+    }
 }
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "planning_tracer.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <ros/ros.h>
+
+namespace arbitrator
+{
+    PlanningTracer::PlanningTracer(const std::string &trace_file_path) :
+        epoch_(Clock::now()),
+        cycle_start_(epoch_),
+        cycle_count_(0)
+    {
+        if (!trace_file_path.empty())
+        {
+            trace_file_.open(trace_file_path, std::ios::out | std::ios::trunc);
+            if (trace_file_.is_open())
+            {
+                // The trace event format permits the closing bracket to be omitted, so events can be streamed
+                trace_file_ << std::fixed << std::setprecision(3) << "[" << std::endl;
+            }
+            else
+            {
+                ROS_WARN_STREAM("Unable to open planning trace file " << trace_file_path);
+            }
+        }
+    }
+
+    double PlanningTracer::to_trace_us(Clock::time_point t) const
+    {
+        return std::chrono::duration<double, std::micro>(t - epoch_).count();
+    }
+
+    int PlanningTracer::get_thread_index()
+    {
+        // Assumes mutex_ is held
+        auto it = thread_indices_.find(std::this_thread::get_id());
+        if (it == thread_indices_.end())
+        {
+            it = thread_indices_.emplace(std::this_thread::get_id(), static_cast<int>(thread_indices_.size())).first;
+        }
+        return it->second;
+    }
+
+    void PlanningTracer::begin_cycle()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_ = PlanningCycleRecord();
+        current_.cycle = cycle_count_++;
+        cycle_start_ = Clock::now();
+    }
+
+    void PlanningTracer::end_cycle(size_t plan_size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Clock::time_point end = Clock::now();
+        current_.plan_size = plan_size;
+        current_.total_s = std::chrono::duration<double>(end - cycle_start_).count();
+        current_.events.push_back(TraceEvent{"generate_plan", "planning", 
+            to_trace_us(cycle_start_), to_trace_us(end) - to_trace_us(cycle_start_), get_thread_index()});
+
+        last_ = current_;
+        if (trace_file_.is_open())
+        {
+            write_trace(last_);
+        }
+    }
+
+    void PlanningTracer::record_search_level(size_t open_list_size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_.tree_depth++;
+        current_.open_list_sizes.push_back(open_list_size);
+    }
+
+    void PlanningTracer::record_plugin_call(const std::string &topic, Clock::time_point start, Clock::time_point end, bool success)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double duration = std::chrono::duration<double>(end - start).count();
+        PluginCallStatistics &stats = current_.plugin_calls[topic];
+        stats.calls++;
+        stats.failures += success ? 0 : 1;
+        stats.total_s += duration;
+        stats.max_s = std::max(stats.max_s, duration);
+        current_.events.push_back(TraceEvent{topic, "plugin", to_trace_us(start), duration * 1e6, get_thread_index()});
+    }
+
+    void PlanningTracer::record_cost_evaluation(Clock::time_point start, Clock::time_point end)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double duration = std::chrono::duration<double>(end - start).count();
+        current_.cost_function_s += duration;
+        current_.events.push_back(TraceEvent{"cost_function", "cost", to_trace_us(start), duration * 1e6, get_thread_index()});
+    }
+
+    void PlanningTracer::record_plan_cost(const std::map<std::string, double> &cost_terms)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_.plan_cost_terms = cost_terms;
+    }
+
+    PlanningCycleRecord PlanningTracer::get_last_cycle() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_;
+    }
+
+    void PlanningTracer::write_trace(const PlanningCycleRecord &record)
+    {
+        // Assumes mutex_ is held
+        for (auto it = record.events.begin(); it != record.events.end(); it++)
+        {
+            trace_file_ << "{\"name\":\"" << it->name << "\",\"cat\":\"" << it->category 
+                << "\",\"ph\":\"X\",\"ts\":" << it->start_us << ",\"dur\":" << it->duration_us 
+                << ",\"pid\":0,\"tid\":" << it->thread_index 
+                << ",\"args\":{\"cycle\":" << record.cycle << "}},\n";
+        }
+
+        // Per-cycle summary as counter events so search shape can be plotted over time
+        const TraceEvent &cycle_event = record.events.back();
+        trace_file_ << "{\"name\":\"search\",\"ph\":\"C\",\"ts\":" << cycle_event.start_us 
+            << ",\"pid\":0,\"args\":{\"tree_depth\":" << record.tree_depth 
+            << ",\"max_open_list\":" << (record.open_list_sizes.empty() ? 0 : 
+                *std::max_element(record.open_list_sizes.begin(), record.open_list_sizes.end())) 
+            << ",\"plan_size\":" << record.plan_size << "}},\n";
+        if (!record.plan_cost_terms.empty())
+        {
+            trace_file_ << "{\"name\":\"plan_cost\",\"ph\":\"C\",\"ts\":" << cycle_event.start_us << ",\"pid\":0,\"args\":{";
+            for (auto it = record.plan_cost_terms.begin(); it != record.plan_cost_terms.end(); it++)
+            {
+                trace_file_ << (it == record.plan_cost_terms.begin() ? "" : ",") << "\"" << it->first << "\":" << it->second;
+            }
+            trace_file_ << "}},\n";
+        }
+        trace_file_.flush();
+    }
+}
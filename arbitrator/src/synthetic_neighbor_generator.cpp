@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "synthetic_neighbor_generator.hpp"
+#include "arbitrator_utils.hpp"
+#include <thread>
+#include <chrono>
+
+namespace arbitrator
+{
+    std::vector<cav_msgs::ManeuverPlan> SyntheticNeighborGenerator::generate_neighbors(cav_msgs::ManeuverPlan plan) const
+    {
+        // New maneuvers start where the plan currently ends
+        ros::Time start_time = plan.maneuvers.empty() ? ros::Time(0) : arbitrator_utils::get_plan_end_time(plan);
+        double start_dist = plan.maneuvers.empty() ? 0.0 : arbitrator_utils::get_plan_end_distance(plan);
+
+        std::vector<cav_msgs::ManeuverPlan> out;
+        for (auto it = plugins_.begin(); it != plugins_.end(); it++)
+        {
+            call_count_++;
+            if (it->latency > ros::Duration(0))
+            {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(it->latency.toNSec()));
+            }
+
+            for (int i = 0; i < it->branching_factor; i++)
+            {
+                double duration, speed;
+                {
+                    std::lock_guard<std::mutex> lock(rng_mutex_);
+                    duration = std::uniform_real_distribution<double>(it->min_maneuver_duration, it->max_maneuver_duration)(rng_);
+                    speed = std::uniform_real_distribution<double>(it->min_speed, it->max_speed)(rng_);
+                }
+
+                cav_msgs::Maneuver mvr;
+                mvr.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+                mvr.lane_following_maneuver.start_time = start_time;
+                mvr.lane_following_maneuver.end_time = start_time + ros::Duration(duration);
+                mvr.lane_following_maneuver.start_dist = start_dist;
+                mvr.lane_following_maneuver.end_dist = start_dist + speed * duration;
+                mvr.lane_following_maneuver.start_speed = speed;
+                mvr.lane_following_maneuver.end_speed = speed;
+                mvr.lane_following_maneuver.parameters.planning_strategic_plugin = it->name;
+                mvr.lane_following_maneuver.parameters.maneuver_id = it->name + "_" + std::to_string(plan.maneuvers.size()) + "_" + std::to_string(i);
+
+                cav_msgs::ManeuverPlan child = plan;
+                child.maneuvers.push_back(mvr);
+                out.push_back(child);
+            }
+        }
+
+        return out;
+    }
+
+    size_t SyntheticNeighborGenerator::get_call_count() const
+    {
+        return call_count_;
+    }
+
+    void SyntheticNeighborGenerator::reset_call_count()
+    {
+        call_count_ = 0;
+    }
+}
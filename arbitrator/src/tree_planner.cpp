@@ -19,12 +19,36 @@
 #include <vector>
 #include <map>
 #include <limits>
+#include <utility>
 
 namespace arbitrator
 {
     cav_msgs::ManeuverPlan TreePlanner::generate_plan() const
     {
-        cav_msgs::ManeuverPlan root;
+        // Without a seed every plan starts at its first maneuver, so measure durations from there
+        return generate_plan(cav_msgs::ManeuverPlan(), ros::Time(0));
+    }
+
+    cav_msgs::ManeuverPlan TreePlanner::generate_plan(const cav_msgs::ManeuverPlan &seed, ros::Time planning_start) const
+    {
+        if (tracer_ == nullptr)
+        {
+            return search(seed, planning_start);
+        }
+
+        tracer_->begin_cycle();
+        cav_msgs::ManeuverPlan plan = search(seed, planning_start);
+        if (!plan.maneuvers.empty())
+        {
+            tracer_->record_plan_cost(cost_function_.compute_cost_terms(plan));
+        }
+        tracer_->end_cycle(plan.maneuvers.size());
+        return plan;
+    }
+
+    cav_msgs::ManeuverPlan TreePlanner::search(const cav_msgs::ManeuverPlan &seed, ros::Time planning_start) const
+    {
+        cav_msgs::ManeuverPlan root = seed;
         std::vector<std::pair<cav_msgs::ManeuverPlan, double>> open_list;
         const double INF = std::numeric_limits<double>::infinity();
         open_list.push_back(std::make_pair(root, INF));
@@ -34,17 +58,20 @@ namespace arbitrator
 
         while (!open_list.empty())
         {
-            std::vector<std::pair<cav_msgs::ManeuverPlan, double>> new_open_list;
+            if (tracer_ != nullptr)
+            {
+                tracer_->record_search_level(open_list.size());
+            }
+
+            // Evaluate terminal condition for every plan at this depth before spending any plugin calls
             for (auto it = open_list.begin(); it != open_list.end(); it++)
             {
-                // Pop the first element off the open list
-                cav_msgs::ManeuverPlan cur_plan = it->first;
+                const cav_msgs::ManeuverPlan &cur_plan = it->first;
 
                 // If we're not at the root (our plan should have maneuvers)
                 if (!cur_plan.maneuvers.empty()) 
                 {
-                    // Evaluate terminal condition
-                    ros::Duration plan_duration = arbitrator_utils::get_plan_end_time(cur_plan) - arbitrator_utils::get_plan_start_time(cur_plan);
+                    ros::Duration plan_duration = arbitrator_utils::get_plan_remaining_duration(cur_plan, planning_start);
                     if (plan_duration >= target_plan_duration_) 
                     {
                         return cur_plan;
@@ -53,14 +80,31 @@ namespace arbitrator
                         longest_plan = cur_plan;
                     }
                 }
+            }
+
+            // Expand every plan at this depth, concurrently if configured to. Each expansion 
+            // writes only its own slot so no synchronization is needed between them.
+            std::vector<std::vector<cav_msgs::ManeuverPlan>> children(open_list.size());
+            std::vector<std::vector<double>> costs(open_list.size());
+            expansion_pool_->parallel_for(open_list.size(), [&](size_t i)
+            {
+                children[i] = neighbor_generator_.generate_neighbors(open_list[i].first);
 
-                // Expand it, and reprioritize
-                std::vector<cav_msgs::ManeuverPlan> children = neighbor_generator_.generate_neighbors(cur_plan);
-                
-                // Compute cost for each child and store in open list
-                for (auto child = children.begin(); child != children.end(); child++)
+                PlanningTracer::Clock::time_point cost_start = PlanningTracer::Clock::now();
+                costs[i] = cost_function_.compute_costs_per_unit_distance(open_list[i].first, children[i]);
+                if (tracer_ != nullptr)
+                {
+                    tracer_->record_cost_evaluation(cost_start, PlanningTracer::Clock::now());
+                }
+            });
+
+            // Merge the children in open list order so results do not depend on thread timing
+            std::vector<std::pair<cav_msgs::ManeuverPlan, double>> new_open_list;
+            for (size_t i = 0; i < open_list.size(); i++)
+            {
+                for (size_t j = 0; j < children[i].size(); j++)
                 {
-                    new_open_list.push_back(std::make_pair(*child, cost_function_.compute_cost_per_unit_distance(*child)));
+                    new_open_list.push_back(std::make_pair(std::move(children[i][j]), costs[i][j]));
                 }
             }
             
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "weighted_cost_function.hpp"
+#include "arbitrator_utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace arbitrator
+{
+    CostWeights CostWeights::from_map(const std::map<std::string, double> &weights)
+    {
+        CostWeights out;
+        for (auto it = weights.begin(); it != weights.end(); it++)
+        {
+            if (it->first == "plugin_priority") 
+            {
+                out.plugin_priority = it->second;
+            } 
+            else if (it->first == "plan_duration") 
+            {
+                out.plan_duration = it->second;
+            } 
+            else if (it->first == "speed_smoothness") 
+            {
+                out.speed_smoothness = it->second;
+            } 
+            else if (it->first == "lane_changes") 
+            {
+                out.lane_changes = it->second;
+            } 
+            else if (it->first == "distance_to_goal") 
+            {
+                out.distance_to_goal = it->second;
+            } 
+            else 
+            {
+                throw std::invalid_argument("Unknown cost function term: " + it->first);
+            }
+        }
+
+        return out;
+    }
+
+    CostBreakdown WeightedCostFunction::compute_cost_breakdown(const cav_msgs::ManeuverPlan &plan) const
+    {
+        CostBreakdown out;
+        if (plan.maneuvers.empty())
+        {
+            return out;
+        }
+
+        double priority = 0.0;
+        double speed_change = 0.0;
+        double lane_changes = 0.0;
+        ros::Time plan_start_time, plan_end_time;
+        double plan_end_dist = 0.0;
+        double prev_end_speed = 0.0;
+
+        for (auto it = plan.maneuvers.begin(); it != plan.maneuvers.end(); it++)
+        {
+            arbitrator_utils::ManeuverProperties props = arbitrator_utils::get_maneuver_properties(*it);
+
+            priority += (props.end_dist - props.start_dist) * priority_cost_.get_plugin_cost(props.parameters->planning_strategic_plugin);
+            speed_change += std::fabs(props.end_speed - props.start_speed);
+            if (it == plan.maneuvers.begin())
+            {
+                plan_start_time = props.start_time;
+            }
+            else
+            {
+                // Discontinuities between maneuvers count against smoothness as well
+                speed_change += std::fabs(props.start_speed - prev_end_speed);
+            }
+            if (it->type == cav_msgs::Maneuver::LANE_CHANGE)
+            {
+                lane_changes += 1.0;
+            }
+
+            prev_end_speed = props.end_speed;
+            plan_end_time = props.end_time;
+            plan_end_dist = props.end_dist;
+        }
+
+        out.plugin_priority = weights_.plugin_priority * priority;
+        out.plan_duration = weights_.plan_duration * (plan_end_time - plan_start_time).toSec();
+        out.speed_smoothness = weights_.speed_smoothness * speed_change;
+        out.lane_changes = weights_.lane_changes * lane_changes;
+        if (route_end_distance_ >= 0.0)
+        {
+            out.distance_to_goal = weights_.distance_to_goal * std::max(0.0, route_end_distance_ - plan_end_dist);
+        }
+        out.total = out.plugin_priority + out.plan_duration + out.speed_smoothness + out.lane_changes + out.distance_to_goal;
+
+        return out;
+    }
+
+    std::map<std::string, double> WeightedCostFunction::compute_cost_terms(const cav_msgs::ManeuverPlan &plan) const
+    {
+        CostBreakdown breakdown = compute_cost_breakdown(plan);
+        return {
+            {"plugin_priority", breakdown.plugin_priority},
+            {"plan_duration", breakdown.plan_duration},
+            {"speed_smoothness", breakdown.speed_smoothness},
+            {"lane_changes", breakdown.lane_changes},
+            {"distance_to_goal", breakdown.distance_to_goal},
+            {"total", breakdown.total}};
+    }
+
+    double WeightedCostFunction::compute_total_cost(const cav_msgs::ManeuverPlan &plan) const
+    {
+        return compute_cost_breakdown(plan).total;
+    }
+
+    double WeightedCostFunction::compute_cost_per_unit_distance(const cav_msgs::ManeuverPlan &plan) const
+    {
+        double plan_dist = arbitrator_utils::get_plan_end_distance(plan) - arbitrator_utils::get_plan_start_distance(plan);
+        return compute_total_cost(plan) / plan_dist;
+    }
+}
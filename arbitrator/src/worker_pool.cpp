@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "worker_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace arbitrator
+{
+    struct WorkerPool::Batch
+    {
+        const std::function<void(size_t)> *task;
+        size_t count;
+        std::atomic<size_t> next_index;
+        // Guarded by mutex
+        size_t completed;
+        std::exception_ptr first_error;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    WorkerPool::WorkerPool(size_t max_threads)
+    {
+        // The calling thread always participates, so one thread fewer is started
+        for (size_t i = 1; i < max_threads; i++)
+        {
+            workers_.emplace_back(&WorkerPool::worker_loop, this);
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+        for (auto it = workers_.begin(); it != workers_.end(); it++)
+        {
+            it->join();
+        }
+    }
+
+    bool WorkerPool::run_next_task(Batch &batch)
+    {
+        size_t i = batch.next_index++;
+        if (i >= batch.count)
+        {
+            return false;
+        }
+
+        std::exception_ptr error;
+        try
+        {
+            (*batch.task)(i);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        if (error && !batch.first_error)
+        {
+            batch.first_error = error;
+        }
+        if (++batch.completed == batch.count)
+        {
+            batch.finished.notify_all();
+        }
+        return true;
+    }
+
+    void WorkerPool::remove_batch(const std::shared_ptr<Batch> &batch)
+    {
+        auto it = std::find(queue_.begin(), queue_.end(), batch);
+        if (it != queue_.end())
+        {
+            queue_.erase(it);
+        }
+    }
+
+    void WorkerPool::worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        while (true)
+        {
+            work_available_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (stopping_)
+            {
+                return;
+            }
+
+            std::shared_ptr<Batch> batch = queue_.front();
+            lock.unlock();
+            bool ran = run_next_task(*batch);
+            lock.lock();
+            if (!ran)
+            {
+                remove_batch(batch);
+            }
+        }
+    }
+
+    void WorkerPool::parallel_for(size_t count, const std::function<void(size_t)> &task)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+        batch->task = &task;
+        batch->count = count;
+        batch->next_index = 0;
+        batch->completed = 0;
+
+        if (!workers_.empty() && count > 1)
+        {
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                queue_.push_back(batch);
+            }
+            work_available_.notify_all();
+        }
+
+        while (run_next_task(*batch)) {}
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            remove_batch(batch);
+        }
+
+        // Tasks claimed by the pool's threads may still be running
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->finished.wait(lock, [&batch]() { return batch->completed == batch->count; });
+        if (batch->first_error)
+        {
+            std::rethrow_exception(batch->first_error);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "test_utils.h"
+#include "caching_neighbor_generator.hpp"
+#include "arbitrator_utils.hpp"
+#include <gmock/gmock.h>
+
+using ::testing::_;
+using ::testing::Return;
+
+namespace arbitrator
+{
+    class MockWrappedNeighborGenerator : public NeighborGenerator
+    {
+        public:
+            MOCK_CONST_METHOD1(generate_neighbors, std::vector<cav_msgs::ManeuverPlan>(cav_msgs::ManeuverPlan));
+            ~MockWrappedNeighborGenerator(){};
+    };
+
+    static cav_msgs::ManeuverPlan build_single_maneuver_plan(std::string maneuver_id, double end_time)
+    {
+        cav_msgs::ManeuverPlan plan;
+        cav_msgs::Maneuver mvr;
+        mvr.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr.lane_following_maneuver.start_time = ros::Time(0);
+        mvr.lane_following_maneuver.end_time = ros::Time(end_time);
+        mvr.lane_following_maneuver.parameters.maneuver_id = maneuver_id;
+        mvr.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_a";
+        plan.maneuvers.push_back(mvr);
+        return plan;
+    }
+
+    TEST(CachingNeighborGeneratorTest, testRepeatedPrefixIsCached)
+    {
+        ros::Time::init();
+        MockWrappedNeighborGenerator mng;
+        CachingNeighborGenerator cng{mng, ros::Duration(10.0)};
+
+        cav_msgs::ManeuverPlan prefix = build_single_maneuver_plan("mvr_a", 5.0);
+        std::vector<cav_msgs::ManeuverPlan> children{build_single_maneuver_plan("mvr_b", 10.0)};
+
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(1)
+            .WillOnce(Return(children));
+
+        ASSERT_EQ(1, cng.generate_neighbors(prefix).size());
+        ASSERT_EQ(1, cng.generate_neighbors(prefix).size());
+    }
+
+    TEST(CachingNeighborGeneratorTest, testDistinctPrefixesAreNotShared)
+    {
+        ros::Time::init();
+        MockWrappedNeighborGenerator mng;
+        CachingNeighborGenerator cng{mng, ros::Duration(10.0)};
+
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(2)
+            .WillRepeatedly(Return(std::vector<cav_msgs::ManeuverPlan>()));
+
+        cng.generate_neighbors(build_single_maneuver_plan("mvr_a", 5.0));
+        cng.generate_neighbors(build_single_maneuver_plan("mvr_a", 6.0));
+    }
+
+    TEST(CachingNeighborGeneratorTest, testRootPlanIsNotCached)
+    {
+        ros::Time::init();
+        MockWrappedNeighborGenerator mng;
+        CachingNeighborGenerator cng{mng, ros::Duration(10.0)};
+
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(2)
+            .WillRepeatedly(Return(std::vector<cav_msgs::ManeuverPlan>()));
+
+        cng.generate_neighbors(cav_msgs::ManeuverPlan());
+        cng.generate_neighbors(cav_msgs::ManeuverPlan());
+    }
+
+    TEST(CachingNeighborGeneratorTest, testKeyDistinguishesDistancesAndSpeeds)
+    {
+        cav_msgs::ManeuverPlan plan = build_single_maneuver_plan("mvr_a", 5.0);
+        plan.maneuvers[0].lane_following_maneuver.start_dist = 1234.5;
+        cav_msgs::ManeuverPlan further = plan;
+        further.maneuvers[0].lane_following_maneuver.start_dist = 1234.6;
+        cav_msgs::ManeuverPlan faster = plan;
+        faster.maneuvers[0].lane_following_maneuver.end_speed = 5.0;
+
+        ASSERT_NE(CachingNeighborGenerator::compute_key(plan), CachingNeighborGenerator::compute_key(further));
+        ASSERT_NE(CachingNeighborGenerator::compute_key(plan), CachingNeighborGenerator::compute_key(faster));
+    }
+
+    TEST(CachingNeighborGeneratorTest, testZeroTtlDisablesCache)
+    {
+        ros::Time::init();
+        MockWrappedNeighborGenerator mng;
+        CachingNeighborGenerator cng{mng, ros::Duration(0.0)};
+
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(2)
+            .WillRepeatedly(Return(std::vector<cav_msgs::ManeuverPlan>()));
+
+        cav_msgs::ManeuverPlan prefix = build_single_maneuver_plan("mvr_a", 5.0);
+        cng.generate_neighbors(prefix);
+        cng.generate_neighbors(prefix);
+    }
+
+    TEST(CachingNeighborGeneratorTest, testGetUnexpiredPlan)
+    {
+        cav_msgs::ManeuverPlan plan = build_single_maneuver_plan("mvr_a", 5.0);
+        plan.maneuvers.push_back(build_single_maneuver_plan("mvr_b", 10.0).maneuvers[0]);
+
+        cav_msgs::ManeuverPlan tail = arbitrator_utils::get_unexpired_plan(plan, ros::Time(7.0));
+        ASSERT_EQ(1, tail.maneuvers.size());
+        ASSERT_EQ("mvr_b", tail.maneuvers[0].lane_following_maneuver.parameters.maneuver_id);
+    }
+}
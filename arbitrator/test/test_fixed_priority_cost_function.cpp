@@ -126,4 +126,84 @@ namespace arbitrator
         double cost2 = fpcf.compute_cost_per_unit_distance(plan2);
         ASSERT_NEAR(0.333/2.0, cost2, 0.01);
     }
+
+    TEST_F(FixedPriorityCostFunctionTest, testChildCostsFromParent)
+    {
+        ros::Time::init();
+        cav_msgs::ManeuverPlan parent, child1, child2;
+        cav_msgs::Maneuver mvr1;
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_dist = 0;
+        mvr1.lane_following_maneuver.end_dist = 1;
+        mvr1.lane_following_maneuver.parameters.maneuver_id = "mvr_1";
+        mvr1.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_a";
+        cav_msgs::Maneuver mvr2;
+        mvr2.type = cav_msgs::Maneuver::LANE_CHANGE;
+        mvr2.lane_change_maneuver.start_dist = 1;
+        mvr2.lane_change_maneuver.end_dist = 2;
+        mvr2.lane_change_maneuver.parameters.planning_strategic_plugin = "plugin_b";
+        cav_msgs::Maneuver mvr3;
+        mvr3.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr3.lane_following_maneuver.start_dist = 1;
+        mvr3.lane_following_maneuver.end_dist = 2;
+        mvr3.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_c";
+
+        parent.maneuvers.push_back(mvr1);
+        child1.maneuvers.push_back(mvr1);
+        child1.maneuvers.push_back(mvr2);
+        child2.maneuvers.push_back(mvr1);
+        child2.maneuvers.push_back(mvr3);
+
+        std::vector<double> costs = fpcf.compute_costs_per_unit_distance(parent, {child1, child2});
+
+        ASSERT_EQ(2, costs.size());
+        ASSERT_NEAR(fpcf.compute_cost_per_unit_distance(child1), costs[0], 0.0001);
+        ASSERT_NEAR(fpcf.compute_cost_per_unit_distance(child2), costs[1], 0.0001);
+        ASSERT_NEAR(0.999/2.0, costs[0], 0.01);
+        ASSERT_NEAR(0.333/2.0, costs[1], 0.01);
+    }
+
+    TEST_F(FixedPriorityCostFunctionTest, testChildWithRewrittenPrefix)
+    {
+        ros::Time::init();
+        cav_msgs::ManeuverPlan parent, child;
+        cav_msgs::Maneuver mvr1;
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_dist = 0;
+        mvr1.lane_following_maneuver.end_dist = 1;
+        mvr1.lane_following_maneuver.parameters.maneuver_id = "mvr_1";
+        mvr1.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_a";
+        cav_msgs::Maneuver mvr1_rewritten = mvr1;
+        mvr1_rewritten.lane_following_maneuver.parameters.maneuver_id = "mvr_1_replanned";
+        mvr1_rewritten.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_c";
+        cav_msgs::Maneuver mvr2;
+        mvr2.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr2.lane_following_maneuver.start_dist = 1;
+        mvr2.lane_following_maneuver.end_dist = 2;
+        mvr2.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_c";
+
+        // The child replaces the parent's maneuver instead of appending to it
+        parent.maneuvers.push_back(mvr1);
+        child.maneuvers.push_back(mvr1_rewritten);
+        child.maneuvers.push_back(mvr2);
+
+        std::vector<double> costs = fpcf.compute_costs_per_unit_distance(parent, {child});
+
+        ASSERT_EQ(1, costs.size());
+        ASSERT_NEAR(fpcf.compute_cost_per_unit_distance(child), costs[0], 0.0001);
+        ASSERT_NEAR(0.0, costs[0], 0.01);
+    }
+
+    TEST_F(FixedPriorityCostFunctionTest, testUnknownPlugin)
+    {
+        cav_msgs::ManeuverPlan plan;
+        cav_msgs::Maneuver mvr1;
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_dist = 0;
+        mvr1.lane_following_maneuver.end_dist = 1;
+        mvr1.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_d";
+        plan.maneuvers.push_back(mvr1);
+
+        ASSERT_THROW(fpcf.compute_total_cost(plan), std::out_of_range);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "test_utils.h"
+#include "planning_tracer.hpp"
+#include "tree_planner.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace arbitrator
+{
+    class StubSearchStrategy : public SearchStrategy
+    {
+        public:
+            std::vector<std::pair<cav_msgs::ManeuverPlan, double>> prioritize_plans(std::vector<std::pair<cav_msgs::ManeuverPlan, double>> plans) const
+            {
+                return plans;
+            }
+    };
+
+    class StubCostFunction : public CostFunction
+    {
+        public:
+            double compute_total_cost(const cav_msgs::ManeuverPlan &plan) const { return 1.0; }
+            double compute_cost_per_unit_distance(const cav_msgs::ManeuverPlan &plan) const { return 1.0; }
+    };
+
+    /**
+     * Neighbor generator which extends each plan with one 2 second maneuver
+     */
+    class StubNeighborGenerator : public NeighborGenerator
+    {
+        public:
+            std::vector<cav_msgs::ManeuverPlan> generate_neighbors(cav_msgs::ManeuverPlan plan) const
+            {
+                cav_msgs::Maneuver mvr;
+                mvr.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+                mvr.lane_following_maneuver.start_time = ros::Time(2.0 * plan.maneuvers.size());
+                mvr.lane_following_maneuver.end_time = ros::Time(2.0 * (plan.maneuvers.size() + 1));
+                plan.maneuvers.push_back(mvr);
+                return {plan};
+            }
+    };
+
+    TEST(PlanningTracerTest, testTreePlannerRecordsCycle)
+    {
+        PlanningTracer tracer;
+        StubSearchStrategy ss;
+        StubCostFunction cf;
+        StubNeighborGenerator ng;
+        TreePlanner tp{cf, ng, ss, ros::Duration(5), &tracer};
+
+        cav_msgs::ManeuverPlan plan = tp.generate_plan();
+        ASSERT_EQ(3, plan.maneuvers.size());
+
+        PlanningCycleRecord record = tracer.get_last_cycle();
+        ASSERT_EQ(0, record.cycle);
+        ASSERT_EQ(4, record.tree_depth);
+        ASSERT_EQ(std::vector<size_t>({1, 1, 1, 1}), record.open_list_sizes);
+        ASSERT_EQ(3, record.plan_size);
+        ASSERT_EQ(1, record.plan_cost_terms.size());
+        ASSERT_EQ(1.0, record.plan_cost_terms["total"]);
+        ASSERT_GE(record.total_s, record.cost_function_s);
+        // One cost evaluation per expansion plus the overall cycle span
+        ASSERT_EQ(4, record.events.size());
+
+        tp.generate_plan();
+        ASSERT_EQ(1, tracer.get_last_cycle().cycle);
+    }
+
+    TEST(PlanningTracerTest, testPluginCallStatistics)
+    {
+        PlanningTracer tracer;
+        tracer.begin_cycle();
+        PlanningTracer::Clock::time_point start = PlanningTracer::Clock::now();
+        tracer.record_plugin_call("plugin_a", start, start + std::chrono::milliseconds(10), true);
+        tracer.record_plugin_call("plugin_a", start, start + std::chrono::milliseconds(30), false);
+        tracer.record_plugin_call("plugin_b", start, start + std::chrono::milliseconds(5), true);
+        tracer.end_cycle(0);
+
+        PlanningCycleRecord record = tracer.get_last_cycle();
+        ASSERT_EQ(2, record.plugin_calls.size());
+        ASSERT_EQ(2, record.plugin_calls["plugin_a"].calls);
+        ASSERT_EQ(1, record.plugin_calls["plugin_a"].failures);
+        ASSERT_NEAR(0.040, record.plugin_calls["plugin_a"].total_s, 0.0001);
+        ASSERT_NEAR(0.030, record.plugin_calls["plugin_a"].max_s, 0.0001);
+        ASSERT_EQ(1, record.plugin_calls["plugin_b"].calls);
+    }
+
+    TEST(PlanningTracerTest, testTraceFileOutput)
+    {
+        std::string path = "/tmp/arbitrator_test_planning_trace.json";
+        {
+            PlanningTracer tracer(path);
+            tracer.begin_cycle();
+            PlanningTracer::Clock::time_point start = PlanningTracer::Clock::now();
+            tracer.record_plugin_call("plugin_a", start, start + std::chrono::milliseconds(10), true);
+            tracer.record_plan_cost({{"total", 2.5}});
+            tracer.end_cycle(1);
+        }
+
+        std::ifstream in(path);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        std::remove(path.c_str());
+
+        ASSERT_EQ('[', contents.str()[0]);
+        ASSERT_NE(std::string::npos, contents.str().find("\"name\":\"plugin_a\",\"cat\":\"plugin\",\"ph\":\"X\""));
+        ASSERT_NE(std::string::npos, contents.str().find("\"name\":\"generate_plan\""));
+        ASSERT_NE(std::string::npos, contents.str().find("\"ph\":\"C\""));
+        ASSERT_NE(std::string::npos, contents.str().find("\"name\":\"plan_cost\",\"ph\":\"C\""));
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "test_utils.h"
+#include "synthetic_neighbor_generator.hpp"
+#include "arbitrator_utils.hpp"
+
+namespace arbitrator
+{
+    TEST(SyntheticNeighborGeneratorTest, testBranchingAndContinuity)
+    {
+        SyntheticPluginConfig plugin_a, plugin_b;
+        plugin_a.name = "plugin_a";
+        plugin_a.branching_factor = 2;
+        plugin_b.name = "plugin_b";
+        plugin_b.branching_factor = 3;
+        SyntheticNeighborGenerator sng{{plugin_a, plugin_b}};
+
+        std::vector<cav_msgs::ManeuverPlan> children = sng.generate_neighbors(cav_msgs::ManeuverPlan());
+        ASSERT_EQ(5, children.size());
+        ASSERT_EQ(2, sng.get_call_count());
+
+        cav_msgs::ManeuverPlan parent = children[0];
+        std::vector<cav_msgs::ManeuverPlan> grandchildren = sng.generate_neighbors(parent);
+        ASSERT_EQ(5, grandchildren.size());
+        ASSERT_EQ(4, sng.get_call_count());
+        for (auto it = grandchildren.begin(); it != grandchildren.end(); it++)
+        {
+            ASSERT_EQ(2, it->maneuvers.size());
+            ASSERT_EQ(arbitrator_utils::get_plan_end_time(parent), arbitrator_utils::get_maneuver_start_time(it->maneuvers[1]));
+            ASSERT_NEAR(arbitrator_utils::get_plan_end_distance(parent), arbitrator_utils::get_maneuver_start_distance(it->maneuvers[1]), 0.0001);
+
+            double duration = (arbitrator_utils::get_maneuver_end_time(it->maneuvers[1]) - arbitrator_utils::get_maneuver_start_time(it->maneuvers[1])).toSec();
+            ASSERT_GE(duration, plugin_a.min_maneuver_duration - 0.0001);
+            ASSERT_LE(duration, plugin_a.max_maneuver_duration + 0.0001);
+        }
+
+        sng.reset_call_count();
+        ASSERT_EQ(0, sng.get_call_count());
+    }
+}
@@ -16,6 +16,8 @@
 
 #include "test_utils.h"
 #include "tree_planner.hpp"
+#include "arbitrator_utils.hpp"
+#include <algorithm>
 #include <gmock/gmock.h>
 
 using ::testing::A;
@@ -24,6 +26,7 @@ using ::testing::DoAll;
 using ::testing::Return;
 using ::testing::ReturnArg;
 using ::testing::InSequence;
+using ::testing::Invoke;
 
 namespace arbitrator
 {
@@ -39,8 +42,8 @@ namespace arbitrator
     class MockCostFunction : public CostFunction
     {
         public:
-            MOCK_CONST_METHOD1(compute_total_cost, double(cav_msgs::ManeuverPlan));
-            MOCK_CONST_METHOD1(compute_cost_per_unit_distance, double(cav_msgs::ManeuverPlan));
+            MOCK_CONST_METHOD1(compute_total_cost, double(const cav_msgs::ManeuverPlan&));
+            MOCK_CONST_METHOD1(compute_cost_per_unit_distance, double(const cav_msgs::ManeuverPlan&));
             ~MockCostFunction(){};
 
     };
@@ -225,4 +228,186 @@ namespace arbitrator
         ASSERT_EQ(ros::Time(4), plan.maneuvers[2].lane_following_maneuver.start_time);
         ASSERT_EQ(ros::Time(5), plan.maneuvers[2].lane_following_maneuver.end_time);
     }
-}
\ No newline at end of file
+
+    TEST_F(TreePlannerTest, testGeneratePlanFromSeed)
+    {
+        cav_msgs::ManeuverPlan seed, plan1;
+        cav_msgs::Maneuver mvr1, mvr2;
+
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_time = ros::Time(0);
+        mvr1.lane_following_maneuver.end_time = ros::Time(3);
+
+        mvr2.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr2.lane_following_maneuver.start_time = ros::Time(3);
+        mvr2.lane_following_maneuver.end_time = ros::Time(5);
+
+        seed.maneuvers.push_back(mvr1);
+
+        plan1.maneuvers.push_back(mvr1);
+        plan1.maneuvers.push_back(mvr2);
+
+        std::vector<cav_msgs::ManeuverPlan> plans1{plan1};
+
+        // The seed is the root, so only its frontier should be expanded
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(1)
+            .WillOnce(
+                Return(plans1)
+            );
+
+        EXPECT_CALL(mcf, compute_cost_per_unit_distance(_))
+            .WillRepeatedly(
+                Return(5.0)
+            );
+
+        EXPECT_CALL(mss, prioritize_plans(_))
+            .WillRepeatedly(
+                ReturnArg<0>()
+            );
+
+        cav_msgs::ManeuverPlan plan = tp.generate_plan(seed, ros::Time(0));
+        ASSERT_EQ(2, plan.maneuvers.size());
+        ASSERT_EQ(ros::Time(0), plan.maneuvers[0].lane_following_maneuver.start_time);
+        ASSERT_EQ(ros::Time(5), plan.maneuvers[1].lane_following_maneuver.end_time);
+    }
+
+    TEST_F(TreePlannerTest, testSeedMeetingTargetIsReused)
+    {
+        cav_msgs::ManeuverPlan seed;
+        cav_msgs::Maneuver mvr1;
+
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_time = ros::Time(0);
+        mvr1.lane_following_maneuver.end_time = ros::Time(6);
+        seed.maneuvers.push_back(mvr1);
+
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(0);
+
+        // 5s of the seed remain after planning starts, which meets the target
+        cav_msgs::ManeuverPlan plan = tp.generate_plan(seed, ros::Time(1));
+        ASSERT_EQ(1, plan.maneuvers.size());
+        ASSERT_EQ(ros::Time(6), plan.maneuvers[0].lane_following_maneuver.end_time);
+    }
+
+    TEST_F(TreePlannerTest, testPartlyElapsedSeedIsExtended)
+    {
+        cav_msgs::ManeuverPlan seed, plan1;
+        cav_msgs::Maneuver mvr1, mvr2;
+
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_time = ros::Time(0);
+        mvr1.lane_following_maneuver.end_time = ros::Time(6);
+
+        mvr2.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr2.lane_following_maneuver.start_time = ros::Time(6);
+        mvr2.lane_following_maneuver.end_time = ros::Time(8);
+
+        seed.maneuvers.push_back(mvr1);
+
+        plan1.maneuvers.push_back(mvr1);
+        plan1.maneuvers.push_back(mvr2);
+
+        std::vector<cav_msgs::ManeuverPlan> plans1{plan1};
+
+        // The seed spanned 6s when planned, but only 3s remain once planning starts at 3s
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(1)
+            .WillOnce(
+                Return(plans1)
+            );
+
+        EXPECT_CALL(mcf, compute_cost_per_unit_distance(_))
+            .WillRepeatedly(
+                Return(5.0)
+            );
+
+        EXPECT_CALL(mss, prioritize_plans(_))
+            .WillRepeatedly(
+                ReturnArg<0>()
+            );
+
+        cav_msgs::ManeuverPlan plan = tp.generate_plan(seed, ros::Time(3));
+        ASSERT_EQ(2, plan.maneuvers.size());
+        ASSERT_EQ(ros::Time(8), plan.maneuvers[1].lane_following_maneuver.end_time);
+    }
+
+    TEST_F(TreePlannerTest, testParallelExpansion)
+    {
+        TreePlanner parallel_tp{mcf, mng, mss, ros::Duration(5), nullptr, 4};
+
+        // Every plan is extended by three 2s maneuvers, the cheapest of which ends latest
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .WillRepeatedly(Invoke([](cav_msgs::ManeuverPlan parent)
+            {
+                ros::Time start = parent.maneuvers.empty() ? ros::Time(0) : arbitrator_utils::get_plan_end_time(parent);
+                std::vector<cav_msgs::ManeuverPlan> children;
+                for (int i = 0; i < 3; i++)
+                {
+                    cav_msgs::Maneuver mvr;
+                    mvr.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+                    mvr.lane_following_maneuver.start_time = start;
+                    mvr.lane_following_maneuver.end_time = start + ros::Duration(2.0 + i * 0.1);
+                    cav_msgs::ManeuverPlan child = parent;
+                    child.maneuvers.push_back(mvr);
+                    children.push_back(child);
+                }
+                return children;
+            }));
+
+        EXPECT_CALL(mcf, compute_cost_per_unit_distance(_))
+            .WillRepeatedly(Invoke([](const cav_msgs::ManeuverPlan &plan)
+            {
+                return -arbitrator_utils::get_plan_end_time(plan).toSec();
+            }));
+
+        // Reverse every level so the merge has to follow the prioritized order rather than the order plans were created in
+        using PlanAndCost = std::pair<cav_msgs::ManeuverPlan, double>;
+        std::vector<std::vector<PlanAndCost>> prioritized_levels;
+        std::vector<std::vector<PlanAndCost>> merged_levels;
+        EXPECT_CALL(mss, prioritize_plans(_))
+            .WillRepeatedly(Invoke([&](std::vector<PlanAndCost> plans)
+            {
+                merged_levels.push_back(plans);
+                std::reverse(plans.begin(), plans.end());
+                prioritized_levels.push_back(plans);
+                return plans;
+            }));
+
+        // Plans in this test are identified by the end times of their maneuvers
+        auto end_times = [](const cav_msgs::ManeuverPlan &p)
+        {
+            std::vector<ros::Time> times;
+            for (auto it = p.maneuvers.begin(); it != p.maneuvers.end(); it++)
+            {
+                times.push_back(it->lane_following_maneuver.end_time);
+            }
+            return times;
+        };
+
+        cav_msgs::ManeuverPlan plan = parallel_tp.generate_plan();
+        ASSERT_EQ(3, plan.maneuvers.size());
+        ASSERT_EQ(ros::Time(0), arbitrator_utils::get_plan_start_time(plan));
+        ASSERT_GE(arbitrator_utils::get_plan_end_time(plan), ros::Time(5));
+        ASSERT_EQ(3, prioritized_levels.size());
+        ASSERT_EQ(end_times(prioritized_levels.back().front().first), end_times(plan));
+
+        // Children are merged grouped by parent in prioritized order, each group in the order it was generated
+        for (size_t level = 1; level < merged_levels.size(); level++)
+        {
+            const std::vector<PlanAndCost> &parents = prioritized_levels[level - 1];
+            const std::vector<PlanAndCost> &merged = merged_levels[level];
+            ASSERT_EQ(3 * parents.size(), merged.size());
+            for (size_t i = 0; i < merged.size(); i++)
+            {
+                cav_msgs::ManeuverPlan prefix = merged[i].first;
+                cav_msgs::Maneuver appended = prefix.maneuvers.back();
+                prefix.maneuvers.pop_back();
+                ASSERT_EQ(end_times(parents[i / 3].first), end_times(prefix));
+                ASSERT_EQ(arbitrator_utils::get_plan_end_time(prefix) + ros::Duration(2.0 + (i % 3) * 0.1), 
+                    appended.lane_following_maneuver.end_time);
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "test_utils.h"
+#include "weighted_cost_function.hpp"
+
+namespace arbitrator
+{
+    class WeightedCostFunctionTest : public ::testing::Test 
+    {
+        public:
+            WeightedCostFunctionTest():
+                fpcf{{
+                    {"plugin_a", 10.0}, 
+                    {"plugin_b", 5.0}, 
+                    {"plugin_c", 15.0}}} 
+            {
+                cav_msgs::Maneuver mvr1;
+                mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+                mvr1.lane_following_maneuver.start_dist = 0;
+                mvr1.lane_following_maneuver.end_dist = 10;
+                mvr1.lane_following_maneuver.start_time = ros::Time(0);
+                mvr1.lane_following_maneuver.end_time = ros::Time(2);
+                mvr1.lane_following_maneuver.start_speed = 5;
+                mvr1.lane_following_maneuver.end_speed = 7;
+                mvr1.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_a";
+
+                cav_msgs::Maneuver mvr2;
+                mvr2.type = cav_msgs::Maneuver::LANE_CHANGE;
+                mvr2.lane_change_maneuver.start_dist = 10;
+                mvr2.lane_change_maneuver.end_dist = 20;
+                mvr2.lane_change_maneuver.start_time = ros::Time(2);
+                mvr2.lane_change_maneuver.end_time = ros::Time(3);
+                mvr2.lane_change_maneuver.start_speed = 8;
+                mvr2.lane_change_maneuver.end_speed = 8;
+                mvr2.lane_change_maneuver.parameters.planning_strategic_plugin = "plugin_c";
+
+                plan.maneuvers.push_back(mvr1);
+                plan.maneuvers.push_back(mvr2);
+            };
+            FixedPriorityCostFunction fpcf;
+            cav_msgs::ManeuverPlan plan;
+    };
+
+    TEST_F(WeightedCostFunctionTest, testDefaultWeightsMatchFixedPriority)
+    {
+        WeightedCostFunction wcf{fpcf, CostWeights()};
+
+        ASSERT_NEAR(fpcf.compute_total_cost(plan), wcf.compute_total_cost(plan), 0.0001);
+        ASSERT_NEAR(fpcf.compute_cost_per_unit_distance(plan), wcf.compute_cost_per_unit_distance(plan), 0.0001);
+    }
+
+    TEST_F(WeightedCostFunctionTest, testBreakdown)
+    {
+        CostWeights weights = CostWeights::from_map({
+            {"plugin_priority", 1.0},
+            {"plan_duration", 2.0},
+            {"speed_smoothness", 3.0},
+            {"lane_changes", 4.0},
+            {"distance_to_goal", 0.5}});
+        WeightedCostFunction wcf{fpcf, weights, 30.0};
+
+        CostBreakdown breakdown = wcf.compute_cost_breakdown(plan);
+
+        ASSERT_NEAR(3.333, breakdown.plugin_priority, 0.01);
+        ASSERT_NEAR(6.0, breakdown.plan_duration, 0.0001);
+        ASSERT_NEAR(9.0, breakdown.speed_smoothness, 0.0001);
+        ASSERT_NEAR(4.0, breakdown.lane_changes, 0.0001);
+        ASSERT_NEAR(5.0, breakdown.distance_to_goal, 0.0001);
+        ASSERT_NEAR(27.333, breakdown.total, 0.01);
+        ASSERT_NEAR(breakdown.total, wcf.compute_total_cost(plan), 0.0001);
+        ASSERT_NEAR(breakdown.total / 20.0, wcf.compute_cost_per_unit_distance(plan), 0.0001);
+
+        std::map<std::string, double> terms = wcf.compute_cost_terms(plan);
+        ASSERT_EQ(6, terms.size());
+        ASSERT_NEAR(breakdown.speed_smoothness, terms["speed_smoothness"], 0.0001);
+        ASSERT_NEAR(breakdown.total, terms["total"], 0.0001);
+    }
+
+    TEST_F(WeightedCostFunctionTest, testUnknownWeight)
+    {
+        ASSERT_THROW(CostWeights::from_map({{"not_a_term", 1.0}}), std::invalid_argument);
+    }
+}
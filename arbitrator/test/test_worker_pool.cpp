@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "worker_pool.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace arbitrator
+{
+    TEST(WorkerPoolTest, testAllTasksRunOnce)
+    {
+        WorkerPool pool{4};
+        std::vector<std::atomic<int>> runs(100);
+        for (auto it = runs.begin(); it != runs.end(); it++)
+        {
+            *it = 0;
+        }
+
+        // The same threads serve every batch
+        for (int batch = 0; batch < 3; batch++)
+        {
+            pool.parallel_for(runs.size(), [&](size_t i) { runs[i]++; });
+        }
+        for (auto it = runs.begin(); it != runs.end(); it++)
+        {
+            ASSERT_EQ(3, it->load());
+        }
+
+        ASSERT_THROW(pool.parallel_for(10, [](size_t i) 
+        {
+            if (i == 5)
+            {
+                throw std::runtime_error("task failed");
+            }
+        }), std::runtime_error);
+    }
+
+    TEST(WorkerPoolTest, testSingleThreadRunsInOrder)
+    {
+        WorkerPool pool{1};
+        std::vector<size_t> order;
+        pool.parallel_for(5, [&](size_t i) { order.push_back(i); });
+        ASSERT_EQ((std::vector<size_t>{0, 1, 2, 3, 4}), order);
+    }
+
+    TEST(WorkerPoolTest, testNestedBatchesComplete)
+    {
+        // Every thread of the pool may be busy with an outer task when the inner batches are submitted
+        WorkerPool pool{2};
+        std::atomic<int> runs(0);
+        pool.parallel_for(4, [&](size_t i)
+        {
+            pool.parallel_for(8, [&](size_t j) { runs++; });
+        });
+        ASSERT_EQ(32, runs.load());
+    }
+}
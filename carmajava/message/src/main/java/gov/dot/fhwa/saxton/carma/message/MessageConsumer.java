@@ -102,6 +102,8 @@ public class MessageConsumer extends SaxtonBaseNode {
     protected boolean publishOutboundMobilityPath_ = true;
     protected boolean publishOutboundMobilityResponse_ = true;
     protected boolean publishOutboundMobilityOperation_ = true;
+    protected boolean decodeJ2735Natively_ = false; // BSM, SPAT and MAP are decoded by the j2735_convertor node instead
+    protected boolean useDirectBufferJni_ = false; // Mobility messages cross JNI in one direct ByteBuffer
     
 	@Override
 	public GraphName getDefaultNodeName() {
@@ -123,12 +125,16 @@ public class MessageConsumer extends SaxtonBaseNode {
             publishOutboundMobilityPath_ = param.getBoolean("~/publish_outbound_mobility_path", true);
             publishOutboundMobilityResponse_ = param.getBoolean("~/publish_outbound_mobility_response", true);
             publishOutboundMobilityOperation_ = param.getBoolean("~/publish_outbound_mobility_operation", true);
+            decodeJ2735Natively_ = param.getBoolean("~/decode_j2735_natively", false);
+            useDirectBufferJni_ = param.getBoolean("~/use_direct_buffer_jni", false);
         }catch (Exception e) {
             log_.warn("STARTUP", "Error reading Message parameters. Using defaults.");
         }
         log_.debug("Read params to publish outbound: BSM = " + publishOutboundBsm_ + ", REQUEST = " + publishOutboundMobilityRequest_);
         log_.debug("Read params to publish outbound: PATH = " + publishOutboundMobilityPath_ + ", RESPONSE = " + publishOutboundMobilityResponse_);
         log_.debug("Read params to publish outbound: OPERATION = " + publishOutboundMobilityOperation_);
+        log_.debug("Read param to leave BSM, SPAT and MAP decoding to j2735_convertor: " + decodeJ2735Natively_);
+        log_.debug("Read param to encode and decode Mobility messages through direct buffers: " + useDirectBufferJni_);
 
         //initialize message statistic
 		messageCounters = new MessageStatistic(connectedNode_, log_);
@@ -208,7 +214,12 @@ public class MessageConsumer extends SaxtonBaseNode {
         mobilityOperationSub_.addMessageListener((op) -> dsrcMessageQueue.add(new MessageContainer("MobilityOperation", op)));
         inboundSub_.addMessageListener((msg) -> {
 		    messageCounters.onMessageReceiving(msg.getMessageType());
-		    IMessage<?> message = DSRCMessageFactory.getMessage(msg.getMessageType(), connectedNode_, log_, connectedNode_.getTopicMessageFactory());
+		    if(decodeJ2735Natively_ && (msg.getMessageType().equals("BSM") ||
+		                                msg.getMessageType().equals("SPAT") ||
+		                                msg.getMessageType().equals("MAP"))) {
+		        return;
+		    }
+		    IMessage<?> message = DSRCMessageFactory.getMessage(msg.getMessageType(), connectedNode_, log_, connectedNode_.getTopicMessageFactory(), useDirectBufferJni_);
 		    if(message != null) {
 		        MessageContainer decodedMessage = message.decode(msg);
 	            if(decodedMessage.getMessage() != null) {
@@ -262,7 +273,7 @@ public class MessageConsumer extends SaxtonBaseNode {
 				   (mtype.equals("MobilityPath") && publishOutboundMobilityPath_) ||
 				   (mtype.equals("MobilityResponse") && publishOutboundMobilityResponse_) ||
 				   (mtype.equals("MobilityOperation") && publishOutboundMobilityOperation_)) {
-			        IMessage<?> message = DSRCMessageFactory.getMessage(outgoingMessage.getType(), connectedNode_, log_, connectedNode_.getTopicMessageFactory());
+			        IMessage<?> message = DSRCMessageFactory.getMessage(outgoingMessage.getType(), connectedNode_, log_, connectedNode_.getTopicMessageFactory(), useDirectBufferJni_);
                     if(message != null) {
                         log_.debug("Found message factory on type " + outgoingMessage.getType());
                         MessageContainer encodedMessage = message.encode(outgoingMessage.getMessage());
@@ -23,17 +23,25 @@ import gov.dot.fhwa.saxton.carma.rosutils.SaxtonLogger;
 
 public class DSRCMessageFactory {
     public static IMessage<?> getMessage(String messageType, ConnectedNode node, SaxtonLogger log, MessageFactory factory) {
+        return getMessage(messageType, node, log, factory, false);
+    }
+
+    /**
+     * @param useDirectBuffer let Mobility messages use the native methods taking a single direct ByteBuffer
+     */
+    public static IMessage<?> getMessage(String messageType, ConnectedNode node, SaxtonLogger log, MessageFactory factory,
+            boolean useDirectBuffer) {
         switch(messageType) {
         case "BSM":
             return new BSMMessage(node, log, factory);
         case "MobilityRequest":
-            return new MobilityRequestMessage(log, factory);
+            return new MobilityRequestMessage(log, factory, useDirectBuffer);
         case "MobilityPath":
-            return new MobilityPathMessage(log, factory);
+            return new MobilityPathMessage(log, factory, useDirectBuffer);
         case "MobilityResponse":
-            return new MobilityResponseMessage(log, factory);
+            return new MobilityResponseMessage(log, factory, useDirectBuffer);
         case "MobilityOperation":
-            return new MobilityOperationMessage(factory, log);
+            return new MobilityOperationMessage(factory, log, useDirectBuffer);
         case "MAP":
             return new MapMessage(factory, log);
         case "SPAT":
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+package gov.dot.fhwa.saxton.carma.message.factory;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.Arrays;
+import java.util.LinkedList;
+import java.util.List;
+import java.util.function.Consumer;
+import java.util.function.ToIntFunction;
+
+import org.jboss.netty.buffer.ChannelBuffer;
+import org.ros.message.MessageFactory;
+
+import cav_msgs.LocationECEF;
+import cav_msgs.LocationOffsetECEF;
+import cav_msgs.MobilityHeader;
+import gov.dot.fhwa.saxton.carma.message.helper.MobilityECEFLocationHelper;
+import gov.dot.fhwa.saxton.carma.message.helper.MobilityHeaderHelper;
+import gov.dot.fhwa.saxton.carma.message.helper.StringConverterHelper;
+
+/**
+ * This class packs Mobility message fields into the direct ByteBuffer passed to the buffer based native methods
+ * and unpacks decoded fields from it, following the field buffer layout described in lib_asn1c/src/wrapper.c.
+ * Each thread reuses one buffer, so a message crosses JNI in a single call without any per field array copies.
+ */
+class MobilityBuffer {
+
+    protected static final int STATIC_ID_MAX_LENGTH = 16;
+    protected static final int BSM_ID_LENGTH = 8;
+    protected static final int PLAN_ID_LENGTH = 36;
+    protected static final int TIMESTAMP_LENGTH = 19;
+    protected static final int STRATEGY_MAX_LENGTH = 50;
+    protected static final int STRATEGY_PARAMS_MAX_LENGTH = 100;
+    protected static final int OFFSETS_LIST_MAX_LENGTH = 60;
+    // Large enough for the fields of every Mobility message and most encoded messages
+    protected static final int INITIAL_CAPACITY = 2048;
+
+    private static final ThreadLocal<ByteBuffer> buffers = ThreadLocal.withInitial(() -> allocate(INITIAL_CAPACITY));
+
+    private static ByteBuffer allocate(int capacity) {
+        return ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+    }
+
+    /**
+     * Get the buffer of the calling thread, replacing it when it is smaller than the requested capacity
+     */
+    static ByteBuffer get(int capacity) {
+        ByteBuffer buffer = buffers.get();
+        if(buffer.capacity() < capacity) {
+            buffer = allocate(capacity);
+            buffers.set(buffer);
+        }
+        buffer.clear();
+        return buffer;
+    }
+
+    /**
+     * Get the buffer of the calling thread holding the content of an encoded message at its start
+     */
+    static ByteBuffer wrapEncoded(ChannelBuffer content) {
+        ByteBuffer buffer = get(Math.max(content.capacity(), INITIAL_CAPACITY));
+        ByteBuffer target = buffer.duplicate();
+        target.limit(content.capacity());
+        content.getBytes(0, target);
+        return buffer;
+    }
+
+    /**
+     * Pack the fields of a message and encode them with a buffer based native method. Messages which do not fit
+     * the buffer are packed and encoded again into a buffer of the size reported by the native method.
+     * @return encoded message or null when encoding failed
+     */
+    static byte[] encode(Consumer<ByteBuffer> packer, ToIntFunction<ByteBuffer> encoder) {
+        ByteBuffer buffer = get(INITIAL_CAPACITY);
+        packer.accept(buffer);
+        int length = encoder.applyAsInt(buffer);
+        if(length > buffer.capacity()) {
+            buffer = get(length);
+            packer.accept(buffer);
+            length = encoder.applyAsInt(buffer);
+        }
+        if(length < 0 || length > buffer.capacity()) {
+            return null;
+        }
+        return readEncoded(buffer, length);
+    }
+
+    /**
+     * Copy an encoded message out of the start of a buffer
+     */
+    static byte[] readEncoded(ByteBuffer buffer, int length) {
+        byte[] encoded = new byte[length];
+        buffer.clear();
+        buffer.get(encoded);
+        return encoded;
+    }
+
+    static void putString(ByteBuffer buffer, byte[] content, int maxLength) {
+        buffer.put((byte) content.length);
+        putFixed(buffer, content, maxLength);
+    }
+
+    static void putFixed(ByteBuffer buffer, byte[] content, int length) {
+        int start = buffer.position();
+        buffer.put(content, 0, Math.min(content.length, length));
+        buffer.position(start + length);
+    }
+
+    static void putHeader(ByteBuffer buffer, MobilityHeaderHelper header) {
+        putString(buffer, header.getSenderId(), STATIC_ID_MAX_LENGTH);
+        putString(buffer, header.getTargetId(), STATIC_ID_MAX_LENGTH);
+        putFixed(buffer, header.getBSMId(), BSM_ID_LENGTH);
+        putFixed(buffer, header.getPlanId(), PLAN_ID_LENGTH);
+        putFixed(buffer, header.getTimestamp(), TIMESTAMP_LENGTH);
+    }
+
+    static void putLocation(ByteBuffer buffer, MobilityECEFLocationHelper location) {
+        buffer.putInt(location.getEcefX());
+        buffer.putInt(location.getEcefY());
+        buffer.putInt(location.getEcefZ());
+        putFixed(buffer, location.getTimestamp(), TIMESTAMP_LENGTH);
+    }
+
+    /**
+     * Put trajectory offsets given as {x[], y[], z[]} like the array based native methods take them
+     */
+    static void putTrajectory(ByteBuffer buffer, int[][] offsets) {
+        int count = Math.min(offsets[0].length, OFFSETS_LIST_MAX_LENGTH);
+        buffer.put((byte) count);
+        for(int[] axis : offsets) {
+            int start = buffer.position();
+            buffer.asIntBuffer().put(axis, 0, count);
+            buffer.position(start + OFFSETS_LIST_MAX_LENGTH * Integer.BYTES);
+        }
+    }
+
+    static String getString(ByteBuffer buffer, int maxLength) {
+        int length = Math.min(buffer.get() & 0xFF, maxLength);
+        byte[] content = getFixed(buffer, maxLength);
+        return StringConverterHelper.readDynamicLengthString(Arrays.copyOf(content, length));
+    }
+
+    static byte[] getFixed(ByteBuffer buffer, int length) {
+        byte[] content = new byte[length];
+        buffer.get(content);
+        return content;
+    }
+
+    static long getTimestamp(ByteBuffer buffer) {
+        return Long.parseLong(new String(getFixed(buffer, TIMESTAMP_LENGTH)));
+    }
+
+    static void getHeader(ByteBuffer buffer, MobilityHeader header) {
+        header.setSenderId(getString(buffer, STATIC_ID_MAX_LENGTH));
+        header.setRecipientId(getString(buffer, STATIC_ID_MAX_LENGTH));
+        header.setSenderBsmId(new String(getFixed(buffer, BSM_ID_LENGTH)));
+        header.setPlanId(new String(getFixed(buffer, PLAN_ID_LENGTH)));
+        header.setTimestamp(getTimestamp(buffer));
+    }
+
+    static void getLocation(ByteBuffer buffer, LocationECEF location) {
+        location.setEcefX(buffer.getInt());
+        location.setEcefY(buffer.getInt());
+        location.setEcefZ(buffer.getInt());
+        location.setTimestamp(getTimestamp(buffer));
+    }
+
+    /**
+     * Skip fields which are optional and absent in the decoded message
+     */
+    static void skip(ByteBuffer buffer, int length) {
+        buffer.position(buffer.position() + length);
+    }
+
+    static void skipLocation(ByteBuffer buffer) {
+        skip(buffer, 3 * Integer.BYTES + TIMESTAMP_LENGTH);
+    }
+
+    static List<LocationOffsetECEF> getTrajectory(ByteBuffer buffer, MessageFactory factory) {
+        int count = buffer.get() & 0xFF;
+        int start = buffer.position();
+        List<LocationOffsetECEF> offsets = new LinkedList<LocationOffsetECEF>();
+        for(int i = 0; i < count; i++) {
+            LocationOffsetECEF offset = factory.newFromType(LocationOffsetECEF._TYPE);
+            offset.setOffsetX((short) buffer.getInt(start + i * Integer.BYTES));
+            offset.setOffsetY((short) buffer.getInt(start + (OFFSETS_LIST_MAX_LENGTH + i) * Integer.BYTES));
+            offset.setOffsetZ((short) buffer.getInt(start + (2 * OFFSETS_LIST_MAX_LENGTH + i) * Integer.BYTES));
+            offsets.add(offset);
+        }
+        buffer.position(start + 3 * OFFSETS_LIST_MAX_LENGTH * Integer.BYTES);
+        return offsets;
+    }
+}
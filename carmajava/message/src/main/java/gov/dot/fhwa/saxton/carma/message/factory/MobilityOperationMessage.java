@@ -16,6 +16,7 @@
 
 package gov.dot.fhwa.saxton.carma.message.factory;
 
+import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.util.Arrays;
 
@@ -42,10 +43,19 @@ public class MobilityOperationMessage implements IMessage<MobilityOperation> {
     
     private MessageFactory factory;
     private SaxtonLogger   log;
+    private boolean        useDirectBuffer;
     
     public MobilityOperationMessage(MessageFactory factory, SaxtonLogger log) {
-        this.factory = factory;
-        this.log     = log;
+        this(factory, log, false);
+    }
+    
+    /**
+     * @param useDirectBuffer pass all fields through one direct ByteBuffer instead of one array per field
+     */
+    public MobilityOperationMessage(MessageFactory factory, SaxtonLogger log, boolean useDirectBuffer) {
+        this.factory         = factory;
+        this.log             = log;
+        this.useDirectBuffer = useDirectBuffer;
     }
 
     // Load libasn1c.so external C library
@@ -75,9 +85,25 @@ public class MobilityOperationMessage implements IMessage<MobilityOperation> {
     public native int decodeMobilityOperation(byte[] encodedArray, byte[] senderId, byte[] targetId, byte[] bsmId,
             byte[] planId, byte[] timestamp, byte[] strategy, byte[] params);
     
+    /**
+     * This is the declaration for the buffer based native method. It takes the MobilityOperation fields packed
+     * by MobilityBuffer into a direct ByteBuffer and writes the encoded message to the start of the same buffer.
+     * @return length of the encoded message; -1 means encode failed; a length larger than the buffer capacity
+     * means the buffer is too small
+     */
+    private native int encodeMobilityOperationBuffer(ByteBuffer buffer);
+    
+    /**
+     * This is the declaration for the buffer based native method. It decodes the first length bytes of a direct
+     * ByteBuffer and packs the MobilityOperation fields into the same buffer for MobilityBuffer to read.
+     * @return -1 means decode failed; 0 means decode is successful
+     */
+    public native int decodeMobilityOperationBuffer(ByteBuffer buffer, int length);
+    
     @Override
     public MessageContainer encode(Message plainMessage) {
-        byte[] encodedMsg = callJniEncode((MobilityOperation) plainMessage);
+        byte[] encodedMsg = useDirectBuffer ? callJniBufferEncode((MobilityOperation) plainMessage)
+                                            : callJniEncode((MobilityOperation) plainMessage);
         if (encodedMsg == null) {
             log.warn("MobilityOperation", "MobilityOperationMessage cannot encode the message");
             return new MessageContainer("ByteArray", null);
@@ -93,6 +119,9 @@ public class MobilityOperationMessage implements IMessage<MobilityOperation> {
 
     @Override
     public MessageContainer decode(ByteArray binaryMessage) {
+        if (useDirectBuffer) {
+            return decodeBuffer(binaryMessage);
+        }
         ChannelBuffer buffer = binaryMessage.getContent();
         byte[] encodedMsg = new byte[buffer.capacity()];
         for (int i = 0; i < buffer.capacity(); i++) {
@@ -123,6 +152,20 @@ public class MobilityOperationMessage implements IMessage<MobilityOperation> {
         return new MessageContainer("MobilityOperation", operation);
     }
 
+    private MessageContainer decodeBuffer(ByteArray binaryMessage) {
+        ByteBuffer buffer = MobilityBuffer.wrapEncoded(binaryMessage.getContent());
+        int result = decodeMobilityOperationBuffer(buffer, binaryMessage.getContent().capacity());
+        if (result == -1) {
+            log.warn("MobilityOperationMessage cannot decode message.");
+            return new MessageContainer("MobilityOperation", null);
+        }
+        MobilityOperation operation = factory.newFromType(MobilityOperation._TYPE);
+        MobilityBuffer.getHeader(buffer, operation.getHeader());
+        operation.setStrategy(MobilityBuffer.getString(buffer, STRATEGY_MAX_LENGTH));
+        operation.setStrategyParams(MobilityBuffer.getString(buffer, STRATEGY_PARAMS_MAX_LENGTH));
+        return new MessageContainer("MobilityOperation", operation);
+    }
+
     public byte[] callJniEncode(MobilityOperation msg) {
         MobilityHeaderHelper header = new MobilityHeaderHelper(msg.getHeader());
         return encodeMobilityOperation(header.getSenderId(), header.getTargetId(),
@@ -131,4 +174,15 @@ public class MobilityOperationMessage implements IMessage<MobilityOperation> {
                             StringConverterHelper.setDynamicLengthString(msg.getStrategyParams(), STRATEGY_PARAMS_MAX_LENGTH));
     }
     
+    public byte[] callJniBufferEncode(MobilityOperation msg) {
+        MobilityHeaderHelper header = new MobilityHeaderHelper(msg.getHeader());
+        byte[] strategy = StringConverterHelper.setDynamicLengthString(msg.getStrategy(), STRATEGY_MAX_LENGTH);
+        byte[] params = StringConverterHelper.setDynamicLengthString(msg.getStrategyParams(), STRATEGY_PARAMS_MAX_LENGTH);
+        return MobilityBuffer.encode(buffer -> {
+            MobilityBuffer.putHeader(buffer, header);
+            MobilityBuffer.putString(buffer, strategy, STRATEGY_MAX_LENGTH);
+            MobilityBuffer.putString(buffer, params, STRATEGY_PARAMS_MAX_LENGTH);
+        }, this::encodeMobilityOperationBuffer);
+    }
+
 }
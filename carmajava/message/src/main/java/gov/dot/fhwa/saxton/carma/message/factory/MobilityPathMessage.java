@@ -16,6 +16,7 @@
 
 package gov.dot.fhwa.saxton.carma.message.factory;
 
+import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.util.Arrays;
 
@@ -40,10 +41,19 @@ public class MobilityPathMessage implements IMessage<MobilityPathMessage> {
 
         private MessageFactory factory;
         private SaxtonLogger log;
+        private boolean useDirectBuffer;
 
         public MobilityPathMessage(SaxtonLogger log, MessageFactory factory) {
+                this(log, factory, false);
+        }
+
+        /**
+         * @param useDirectBuffer pass all fields through one direct ByteBuffer instead of one array per field
+         */
+        public MobilityPathMessage(SaxtonLogger log, MessageFactory factory, boolean useDirectBuffer) {
                 this.factory = factory;
                 this.log = log;
+                this.useDirectBuffer = useDirectBuffer;
         }
 
         // Load libasn1c.so external C library
@@ -77,6 +87,21 @@ public class MobilityPathMessage implements IMessage<MobilityPathMessage> {
                         byte[] bsmId, byte[] planId, byte[] timestamp, Object currentLocation, byte[] locationTimestamp,
                         int[][] offsets);
 
+        /**
+         * This is the declaration for the buffer based native method. It takes the MobilityPath fields packed
+         * by MobilityBuffer into a direct ByteBuffer and writes the encoded message to the start of the same buffer.
+         * @return length of the encoded message; -1 means encode failed; a length larger than the buffer capacity
+         * means the buffer is too small
+         */
+        private native int encodeMobilityPathBuffer(ByteBuffer buffer);
+
+        /**
+         * This is the declaration for the buffer based native method. It decodes the first length bytes of a direct
+         * ByteBuffer and packs the MobilityPath fields into the same buffer for MobilityBuffer to read.
+         * @return -1 means decode failed; 0 means decode is successful
+         */
+        public native int decodeMobilityPathBuffer(ByteBuffer buffer, int length);
+
         public byte[] callJniEncode(MobilityPath message) {
                 MobilityPathHelper helper = new MobilityPathHelper(message);
                 return encodeMobilityPath(helper.getHeaderHelper().getSenderId(),
@@ -89,9 +114,19 @@ public class MobilityPathMessage implements IMessage<MobilityPathMessage> {
                                 helper.getTrajectoryHelper().getOffsets());
         }
 
+        public byte[] callJniBufferEncode(MobilityPath message) {
+                MobilityPathHelper helper = new MobilityPathHelper(message);
+                return MobilityBuffer.encode(buffer -> {
+                        MobilityBuffer.putHeader(buffer, helper.getHeaderHelper());
+                        MobilityBuffer.putLocation(buffer, helper.getTrajectoryHelper().getStartLocationHelper());
+                        MobilityBuffer.putTrajectory(buffer, helper.getTrajectoryHelper().getOffsets());
+                }, this::encodeMobilityPathBuffer);
+        }
+
         @Override
         public MessageContainer encode(Message plainMessage) {
-                byte[] encodedMsg = callJniEncode((MobilityPath) plainMessage);
+                byte[] encodedMsg = useDirectBuffer ? callJniBufferEncode((MobilityPath) plainMessage)
+                                                    : callJniEncode((MobilityPath) plainMessage);
                 if (encodedMsg == null) {
                         log.warn("MobilityRequest", "MobilityPathMessage cannot encode the message");
                         return new MessageContainer("ByteArray", null);
@@ -107,6 +142,9 @@ public class MobilityPathMessage implements IMessage<MobilityPathMessage> {
 
         @Override
         public MessageContainer decode(ByteArray binaryMessage) {
+                if (useDirectBuffer) {
+                        return decodeBuffer(binaryMessage);
+                }
                 ChannelBuffer buffer = binaryMessage.getContent();
                 byte[] encodedMsg = new byte[buffer.capacity()];
                 for (int i = 0; i < buffer.capacity(); i++) {
@@ -143,4 +181,18 @@ public class MobilityPathMessage implements IMessage<MobilityPathMessage> {
                 return new MessageContainer("MobilityPath", path);
         }
 
+        private MessageContainer decodeBuffer(ByteArray binaryMessage) {
+                ByteBuffer buffer = MobilityBuffer.wrapEncoded(binaryMessage.getContent());
+                int result = decodeMobilityPathBuffer(buffer, binaryMessage.getContent().capacity());
+                if (result == -1) {
+                        log.warn("MobilityPathMessage cannot decode message.");
+                        return new MessageContainer("MobilityPath", null);
+                }
+                MobilityPath path = factory.newFromType(MobilityPath._TYPE);
+                MobilityBuffer.getHeader(buffer, path.getHeader());
+                MobilityBuffer.getLocation(buffer, path.getTrajectory().getLocation());
+                path.getTrajectory().setOffsets(MobilityBuffer.getTrajectory(buffer, factory));
+                return new MessageContainer("MobilityPath", path);
+        }
+
 }
\ No newline at end of file
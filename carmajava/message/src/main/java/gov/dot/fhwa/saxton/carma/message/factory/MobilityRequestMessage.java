@@ -16,6 +16,7 @@
 
 package gov.dot.fhwa.saxton.carma.message.factory;
 
+import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.util.Arrays;
 
@@ -27,6 +28,7 @@ import org.ros.message.Time;
 
 import cav_msgs.ByteArray;
 import cav_msgs.MobilityRequest;
+import gov.dot.fhwa.saxton.carma.message.helper.MobilityECEFLocationHelper;
 import gov.dot.fhwa.saxton.carma.message.helper.MobilityRequestHelper;
 import gov.dot.fhwa.saxton.carma.message.helper.MobilityTrajectoryHelper;
 import gov.dot.fhwa.saxton.carma.message.helper.StringConverterHelper;
@@ -40,10 +42,19 @@ public class MobilityRequestMessage implements IMessage<MobilityRequestMessage>{
     
     protected SaxtonLogger log_;
     protected MessageFactory messageFactory_;
+    protected boolean useDirectBuffer_;
     
     public MobilityRequestMessage(SaxtonLogger log, MessageFactory messageFactory) {
+        this(log, messageFactory, false);
+    }
+    
+    /**
+     * @param useDirectBuffer pass all fields through one direct ByteBuffer instead of one array per field
+     */
+    public MobilityRequestMessage(SaxtonLogger log, MessageFactory messageFactory, boolean useDirectBuffer) {
         this.log_ = log;
         this.messageFactory_ = messageFactory;
+        this.useDirectBuffer_ = useDirectBuffer;
     }
 
     // Load libasn1c.so external C library
@@ -80,9 +91,25 @@ public class MobilityRequestMessage implements IMessage<MobilityRequestMessage>{
             Object currentLocation, byte[] locationTime, byte[] strategyParams, Object trajectoryStartLocation,
             byte[] trajectoryStartTime, int[][] offsets, byte[] expiration);
     
+    /**
+     * This is the declaration for the buffer based native method. It takes the MobilityRequest fields packed
+     * by MobilityBuffer into a direct ByteBuffer and writes the encoded message to the start of the same buffer.
+     * @return length of the encoded message; -1 means encode failed; a length larger than the buffer capacity
+     * means the buffer is too small
+     */
+    private native int encodeMobilityRequestBuffer(ByteBuffer buffer);
+    
+    /**
+     * This is the declaration for the buffer based native method. It decodes the first length bytes of a direct
+     * ByteBuffer and packs the MobilityRequest fields into the same buffer for MobilityBuffer to read.
+     * @return -1 means decode failed; 0 means decode is successful
+     */
+    public native int decodeMobilityRequestBuffer(ByteBuffer buffer, int length);
+    
     @Override
     public MessageContainer encode(Message plainMessage) {
-        byte[] encodedMsg = this.callJniEncode((MobilityRequest) plainMessage);
+        byte[] encodedMsg = useDirectBuffer_ ? this.callJniBufferEncode((MobilityRequest) plainMessage)
+                                             : this.callJniEncode((MobilityRequest) plainMessage);
         if(encodedMsg == null) {
             log_.warn("MobilityRequest", "MobilityRequestMessage cannot encode the message");
             return new MessageContainer("ByteArray", null);
@@ -98,6 +125,9 @@ public class MobilityRequestMessage implements IMessage<MobilityRequestMessage>{
 
     @Override
     public MessageContainer decode(ByteArray binaryMessage) {
+        if(useDirectBuffer_) {
+            return decodeBuffer(binaryMessage);
+        }
         ChannelBuffer buffer = binaryMessage.getContent();
         byte[] encodedMsg = new byte[buffer.capacity()];
         for(int i = 0; i < buffer.capacity(); i++) {
@@ -146,6 +176,35 @@ public class MobilityRequestMessage implements IMessage<MobilityRequestMessage>{
         return new MessageContainer("MobilityRequest", request);
     }
     
+    private MessageContainer decodeBuffer(ByteArray binaryMessage) {
+        ByteBuffer buffer = MobilityBuffer.wrapEncoded(binaryMessage.getContent());
+        int result = decodeMobilityRequestBuffer(buffer, binaryMessage.getContent().capacity());
+        if(result == -1) {
+            log_.warn("MobilityRequest", "MobilityRequestMessage cannot decode message.");
+            return new MessageContainer("MobilityRequest", null);
+        }
+        MobilityRequest request = messageFactory_.newFromType(MobilityRequest._TYPE);
+        MobilityBuffer.getHeader(buffer, request.getHeader());
+        request.setStrategy(MobilityBuffer.getString(buffer, MobilityBuffer.STRATEGY_MAX_LENGTH));
+        request.getPlanType().setType((byte) buffer.getInt());
+        request.setUrgency((short) buffer.getInt());
+        MobilityBuffer.getLocation(buffer, request.getLocation());
+        request.setStrategyParams(MobilityBuffer.getString(buffer, MobilityBuffer.STRATEGY_PARAMS_MAX_LENGTH));
+        // trajectory start location and expiration are optional
+        if(buffer.get() != 0) {
+            MobilityBuffer.getLocation(buffer, request.getTrajectory().getLocation());
+        } else {
+            MobilityBuffer.skipLocation(buffer);
+        }
+        request.getTrajectory().setOffsets(MobilityBuffer.getTrajectory(buffer, messageFactory_));
+        if(buffer.get() != 0) {
+            request.setExpiration(MobilityBuffer.getTimestamp(buffer));
+        } else {
+            MobilityBuffer.skip(buffer, MobilityBuffer.TIMESTAMP_LENGTH);
+        }
+        return new MessageContainer("MobilityRequest", request);
+    }
+    
     public byte[] callJniEncode(MobilityRequest request) {
         MobilityRequestHelper helper = new MobilityRequestHelper(request);
         byte[] encodedMsg = encodeMobilityRequest(
@@ -162,6 +221,27 @@ public class MobilityRequestMessage implements IMessage<MobilityRequestMessage>{
         return encodedMsg;
     }
     
+    public byte[] callJniBufferEncode(MobilityRequest request) {
+        MobilityRequestHelper helper = new MobilityRequestHelper(request);
+        MobilityECEFLocationHelper start = helper.getTrajectoryHelper().getStartLocationHelper();
+        // same rules as the array based encoder for the optional trajectory and expiration
+        boolean trajectoryExists = start.getEcefX() != 0 || start.getEcefY() != 0 || start.getEcefZ() != 0;
+        boolean expirationExists = new String(helper.getExpiration()).chars().anyMatch(digit -> digit != '0');
+        return MobilityBuffer.encode(buffer -> {
+            MobilityBuffer.putHeader(buffer, helper.getHeaderHelper());
+            MobilityBuffer.putString(buffer, helper.getStrategy(), MobilityBuffer.STRATEGY_MAX_LENGTH);
+            buffer.putInt(helper.getPlanType());
+            buffer.putInt(helper.getUrgency());
+            MobilityBuffer.putLocation(buffer, helper.getLocationHelper());
+            MobilityBuffer.putString(buffer, helper.getStrategyParams(), MobilityBuffer.STRATEGY_PARAMS_MAX_LENGTH);
+            buffer.put((byte) (trajectoryExists ? 1 : 0));
+            MobilityBuffer.putLocation(buffer, start);
+            MobilityBuffer.putTrajectory(buffer, helper.getTrajectoryHelper().getOffsets());
+            buffer.put((byte) (expirationExists ? 1 : 0));
+            MobilityBuffer.putFixed(buffer, helper.getExpiration(), MobilityBuffer.TIMESTAMP_LENGTH);
+        }, this::encodeMobilityRequestBuffer);
+    }
+    
     public int callJniDecode(byte[] encodedArray, Object mobilityReq, byte[] senderId, byte[] targetId,
             byte[] bsmId, byte[] planId, byte[] timestamp, byte[] strategy, Object planType,
             Object currentLocation, byte[] locationTime, byte[] strategyParams, Object trajectoryStartLocation,
@@ -16,6 +16,7 @@
 
 package gov.dot.fhwa.saxton.carma.message.factory;
 
+import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.util.Arrays;
 
@@ -42,10 +43,19 @@ public class MobilityResponseMessage implements IMessage<MobilityResponse> {
     
     private MessageFactory factory;
     private SaxtonLogger   log;
+    private boolean        useDirectBuffer;
     
     public MobilityResponseMessage(SaxtonLogger log, MessageFactory factory) {
-        this.factory = factory;
-        this.log     = log;
+        this(log, factory, false);
+    }
+    
+    /**
+     * @param useDirectBuffer pass all fields through one direct ByteBuffer instead of one array per field
+     */
+    public MobilityResponseMessage(SaxtonLogger log, MessageFactory factory, boolean useDirectBuffer) {
+        this.factory         = factory;
+        this.log             = log;
+        this.useDirectBuffer = useDirectBuffer;
     }
     
     // Load libasn1c.so external C library
@@ -75,9 +85,25 @@ public class MobilityResponseMessage implements IMessage<MobilityResponse> {
     public native int decodeMobilityResponse(byte[] encodedArray, Object mobilityResponse, byte[] senderId,
             byte[] targetId, byte[] bsmId, byte[] planId, byte[] timestamp);
     
+    /**
+     * This is the declaration for the buffer based native method. It takes the MobilityResponse fields packed
+     * by MobilityBuffer into a direct ByteBuffer and writes the encoded message to the start of the same buffer.
+     * @return length of the encoded message; -1 means encode failed; a length larger than the buffer capacity
+     * means the buffer is too small
+     */
+    private native int encodeMobilityResponseBuffer(ByteBuffer buffer);
+    
+    /**
+     * This is the declaration for the buffer based native method. It decodes the first length bytes of a direct
+     * ByteBuffer and packs the MobilityResponse fields into the same buffer for MobilityBuffer to read.
+     * @return -1 means decode failed; 0 means decode is successful
+     */
+    public native int decodeMobilityResponseBuffer(ByteBuffer buffer, int length);
+    
     @Override
     public MessageContainer encode(Message plainMessage) {
-        byte[] encodedMsg = callJniEncode((MobilityResponse) plainMessage);
+        byte[] encodedMsg = useDirectBuffer ? callJniBufferEncode((MobilityResponse) plainMessage)
+                                            : callJniEncode((MobilityResponse) plainMessage);
         if (encodedMsg == null) {
             log.warn("MobilityResponse", "MobilityResponseMessage cannot encode the message");
             return new MessageContainer("ByteArray", null);
@@ -93,6 +119,9 @@ public class MobilityResponseMessage implements IMessage<MobilityResponse> {
 
     @Override
     public MessageContainer decode(ByteArray binaryMessage) {
+        if (useDirectBuffer) {
+            return decodeBuffer(binaryMessage);
+        }
         ChannelBuffer buffer = binaryMessage.getContent();
         byte[] encodedMsg = new byte[buffer.capacity()];
         for (int i = 0; i < buffer.capacity(); i++) {
@@ -119,6 +148,20 @@ public class MobilityResponseMessage implements IMessage<MobilityResponse> {
         return new MessageContainer("MobilityResponse", response);
     }
 
+    private MessageContainer decodeBuffer(ByteArray binaryMessage) {
+        ByteBuffer buffer = MobilityBuffer.wrapEncoded(binaryMessage.getContent());
+        int result = decodeMobilityResponseBuffer(buffer, binaryMessage.getContent().capacity());
+        if (result == -1) {
+            log.warn("MobilityResponseMessage cannot decode message.");
+            return new MessageContainer("MobilityResponse", null);
+        }
+        MobilityResponse response = factory.newFromType(MobilityResponse._TYPE);
+        MobilityBuffer.getHeader(buffer, response.getHeader());
+        response.setUrgency((short) buffer.getInt());
+        response.setIsAccepted(buffer.get() != 0);
+        return new MessageContainer("MobilityResponse", response);
+    }
+
     public byte[] callJniEncode(MobilityResponse message) {
         MobilityHeaderHelper header = new MobilityHeaderHelper(message.getHeader());
         // we did not use a header class here, so we need to hard-code the upper bound for this value
@@ -127,4 +170,14 @@ public class MobilityResponseMessage implements IMessage<MobilityResponse> {
                                       header.getPlanId(), header.getTimestamp(), urgency, message.getIsAccepted());
     }
     
+    public byte[] callJniBufferEncode(MobilityResponse message) {
+        MobilityHeaderHelper header = new MobilityHeaderHelper(message.getHeader());
+        int urgency = Math.min(Math.max(URGENCY_MIN, message.getUrgency()), URGENCY_MAX);
+        return MobilityBuffer.encode(buffer -> {
+            MobilityBuffer.putHeader(buffer, header);
+            buffer.putInt(urgency);
+            buffer.put((byte) (message.getIsAccepted() ? 1 : 0));
+        }, this::encodeMobilityResponseBuffer);
+    }
+
 }
@@ -17,9 +17,12 @@
 package gov.dot.fhwa.saxton.carma.message;
 
 import static org.junit.Assert.*;
+import static org.junit.Assume.assumeTrue;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.when;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Arrays;
 import java.util.LinkedList;
 import java.util.List;
@@ -64,6 +67,18 @@ public class MobilityPathTest {
         mockStartLocation = mock(LocationECEF.class);
     }
 
+    /**
+     * The buffer based natives are only exported by libasn1c builds made from a wrapper.c which contains them
+     */
+    private boolean bufferNativesAvailable() {
+        try {
+            message.decodeMobilityPathBuffer(ByteBuffer.allocateDirect(1), 0);
+            return true;
+        } catch (UnsatisfiedLinkError e) {
+            return false;
+        }
+    }
+
     @Test
     public void mobilityPathEncodeWithNoOffsets() {
         when(mockStartLocation.getEcefX()).thenReturn(0);
@@ -156,4 +171,52 @@ public class MobilityPathTest {
         System.out.println(Arrays.toString(offsets));
         assertEquals(0, res);
     }
+
+    @Test
+    public void mobilityPathBufferEncodeMatchesArrayEncode() {
+        assumeTrue("libasn1c does not export encodeMobilityPathBuffer", bufferNativesAvailable());
+        when(mockStartLocation.getEcefX()).thenReturn(0);
+        when(mockStartLocation.getEcefY()).thenReturn(0);
+        when(mockStartLocation.getEcefZ()).thenReturn(0);
+        List<LocationOffsetECEF> offsets = new LinkedList<>();
+        for(int i = 0; i < 60; i++) {
+            LocationOffsetECEF offset = mock(LocationOffsetECEF.class);
+            when(offset.getOffsetX()).thenReturn((short) i);
+            when(offset.getOffsetY()).thenReturn((short) -i);
+            when(offset.getOffsetZ()).thenReturn((short) (i / 2));
+            offsets.add(offset);
+        }
+        when(mockTrajectory.getOffsets()).thenReturn(offsets);
+        when(mockTrajectory.getLocation()).thenReturn(mockStartLocation);
+        when(mockPath.getTrajectory()).thenReturn(mockTrajectory);
+
+        byte[] expected = message.callJniEncode(mockPath);
+        assertNotNull(expected);
+        assertArrayEquals(expected, message.callJniBufferEncode(mockPath));
+    }
+
+    @Test
+    public void decodeMobilityPathBufferWithOffsets() {
+        assumeTrue("libasn1c does not export decodeMobilityPathBuffer", bufferNativesAvailable());
+        byte[] decodedMessage = { 0, -14, 108, 77, 90, 113, 39, -44, 90, -47, -85, 22, 12, 2, -35, -42, 44, 32, -62, -121, 18,
+                44, 102, 44, 88, -79, 98, -59, -117, 21, -84, -103, 50, 100, -75, -101, 54, 108, -42, -63, -125, 6, 10,
+                -42, 44, 88, -79, 98, -59, -117, 22, 44, 88, -79, 96, -63, -125, 6, 12, 24, 48, 96, -63, -117, 38, 109,
+                26, -74, 110, -31, -54, 96, -54, -125, 68, -63, -107, 6, -119, -125, 42, 13, 24, 48, 96, -63, -125, 6,
+                12, 24, 48, 96, -63, -125, 6, 12, 24, 48, 96, 27, -4, -1, 63, -48, 68, 17, 4, 65, 16, 108, 36 };
+        ByteBuffer buffer = ByteBuffer.allocateDirect(2048).order(ByteOrder.nativeOrder());
+        buffer.put(decodedMessage);
+        assertEquals(0, message.decodeMobilityPathBuffer(buffer, decodedMessage.length));
+        // sender id length and content lead the header
+        byte[] senderId = new byte[11];
+        buffer.position(1);
+        buffer.get(senderId);
+        assertEquals("USDOT-45100", new String(senderId));
+        // trajectory follows the 97 byte header and the 31 byte location
+        int trajectory = 97 + 31;
+        assertEquals(3, buffer.get(trajectory));
+        assertEquals(10, buffer.getInt(trajectory + 1));
+        assertEquals(25, buffer.getInt(trajectory + 1 + (60 + 2) * 4));
+        assertEquals(30, buffer.getInt(trajectory + 1 + (120 + 2) * 4));
+        assertEquals(-1, message.decodeMobilityPathBuffer(buffer, 4096));
+    }
 }
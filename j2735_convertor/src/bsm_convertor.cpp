@@ -106,6 +106,13 @@ void BSMConvertor::convert(const j2735_msgs::BSM& in_msg, cav_msgs::BSM& out_msg
   convert(in_msg.core_data, out_msg.core_data);
 }
 
+void BSMConvertor::convert(const std::vector<j2735_msgs::BSMConstPtr>& in_msgs, std::vector<cav_msgs::BSM>& out_msgs) {
+  out_msgs.resize(in_msgs.size());
+  for (size_t i = 0; i < in_msgs.size(); i++) {
+    convert(*in_msgs[i], out_msgs[i]);
+  }
+}
+
 ////
 // Convert cav_msgs to j2735_msgs
 ////
@@ -16,6 +16,7 @@
  */
 
 #include <cstdint>
+#include <vector>
 #include <j2735_msgs/BSM.h>
 #include <j2735_msgs/SPAT.h>
 #include <j2735_msgs/MapData.h>
@@ -57,6 +58,16 @@ class BSMConvertor
      * Unit conversions and presence flags are handled
      */
     static void convert(const cav_msgs::BSM& in_msg, j2735_msgs::BSM& out_msg);
+    /**
+     * @brief Convert the contents of a batch of j2735_msgs::BSM into cav_msgs::BSM
+     * 
+     * @param in_msgs The messages to be converted
+     * @param out_msgs The vector to store the output. It is resized to the number of input messages and
+     *                 existing elements are overwritten so their buffers are reused between batches
+     * 
+     * Unit conversions and presence flags are handled
+     */
+    static void convert(const std::vector<j2735_msgs::BSMConstPtr>& in_msgs, std::vector<cav_msgs::BSM>& out_msgs);
 
   private:
     ////
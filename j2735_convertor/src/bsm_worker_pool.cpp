@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * CPP File containing BSMWorkerPool method definitions
+ */
+
+#include <algorithm>
+#include "bsm_worker_pool.h"
+
+BSMWorkerPool::BSMWorkerPool(size_t num_threads, size_t max_queue_depth,
+  std::function<void(const cav_msgs::BSM&)> publish, std::function<void(const std::exception&)> on_exception)
+  : max_queue_depth_(max_queue_depth), publish_(publish), on_exception_(on_exception), running_(true) {
+  
+  for (size_t i = 0; i < num_threads; i++) {
+    workers_.emplace_back(new Worker());
+  }
+  // Threads are started once all workers exist so none observes a partially built pool
+  for (auto& worker : workers_) {
+    Worker* w = worker.get();
+    w->thread = std::thread([this, w]() { work(*w); });
+  }
+}
+
+BSMWorkerPool::~BSMWorkerPool() {
+  stop();
+}
+
+size_t BSMWorkerPool::workerFor(const std::vector<uint8_t>& id, size_t num_workers) {
+  // FNV-1a, temporary ids are random so any reasonable mix spreads them evenly
+  uint32_t hash = 2166136261u;
+  for (uint8_t byte : id) {
+    hash = (hash ^ byte) * 16777619u;
+  }
+  return hash % num_workers;
+}
+
+void BSMWorkerPool::enqueue(const j2735_msgs::BSMConstPtr& message) {
+  Worker& worker = *workers_[workerFor(message->core_data.id, workers_.size())];
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.queue.size() >= max_queue_depth_) {
+      // A queue is shared by many senders, so prefer dropping a message this one supersedes over another sender's only message
+      auto superseded = std::find_if(worker.queue.begin(), worker.queue.end(),
+        [&message](const j2735_msgs::BSMConstPtr& queued) { return queued->core_data.id == message->core_data.id; });
+      worker.queue.erase(superseded != worker.queue.end() ? superseded : worker.queue.begin());
+      worker.dropped++;
+    }
+    worker.queue.push_back(message);
+    worker.max_queue_depth = std::max(worker.max_queue_depth, worker.queue.size());
+  }
+  worker.ready.notify_one();
+}
+
+void BSMWorkerPool::work(Worker& worker) {
+  std::vector<j2735_msgs::BSMConstPtr> batch;
+  std::vector<cav_msgs::BSM> converted;
+
+  while (running_) {
+    {
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      worker.ready.wait(lock, [this, &worker]() { return !running_ || !worker.queue.empty(); });
+      if (!running_) {
+        return;
+      }
+      batch.assign(worker.queue.begin(), worker.queue.end());
+      worker.queue.clear();
+    }
+
+    try {
+      BSMConvertor::convert(batch, converted); // Convert messages
+      for (const cav_msgs::BSM& msg : converted) {
+        publish_(msg); // Publish converted message
+      }
+    }
+    catch(const std::exception& e) {
+      on_exception_(e);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.converted += batch.size();
+    }
+    batch.clear();
+  }
+}
+
+BSMWorkerPool::Stats BSMWorkerPool::getStats() {
+  Stats stats;
+  for (auto& worker : workers_) {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    stats.queue_depth += worker->queue.size();
+    stats.max_queue_depth = std::max(stats.max_queue_depth, worker->max_queue_depth);
+    stats.converted += worker->converted;
+    stats.dropped += worker->dropped;
+  }
+  return stats;
+}
+
+void BSMWorkerPool::stop() {
+  running_ = false;
+  for (auto& worker : workers_) {
+    {
+      // Taking the lock ensures a worker between its predicate check and wait sees the stop
+      std::lock_guard<std::mutex> lock(worker->mutex);
+    }
+    worker->ready.notify_all();
+  }
+  for (auto& worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
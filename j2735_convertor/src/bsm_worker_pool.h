@@ -0,0 +1,117 @@
+#pragma once
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include <j2735_msgs/BSM.h>
+#include <cav_msgs/BSM.h>
+#include "bsm_convertor.h"
+
+/**
+ * @class BSMWorkerPool
+ * @brief Converts incoming J2735 BSMs on a fixed number of worker threads
+ * 
+ * Each message is assigned to a worker by its temporary vehicle id, so messages from one sender are always
+ * converted and published in the order they were received. Workers convert everything queued for them as one batch.
+ * When a worker falls behind, the oldest queued message from the same sender is dropped to make room since BSMs are only
+ * useful while current. If that sender has nothing queued the oldest message overall is dropped instead.
+ */
+class BSMWorkerPool 
+{
+  public:
+    /**
+     * @brief Queue depth and drop counters summed over all workers
+     */
+    struct Stats {
+      size_t queue_depth = 0; // Messages currently waiting for conversion
+      size_t max_queue_depth = 0; // Largest queue depth seen by any single worker
+      uint64_t converted = 0; // Messages converted and published
+      uint64_t dropped = 0; // Messages dropped because a worker queue was full
+    };
+
+    /**
+     * @brief Constructor, starts the worker threads
+     * 
+     * @param num_threads The number of worker threads
+     * @param max_queue_depth The number of messages each worker may have waiting before one is dropped
+     * @param publish Called from a worker thread with each converted message
+     * @param on_exception Called from a worker thread when conversion or publishing throws
+     */
+    BSMWorkerPool(size_t num_threads, size_t max_queue_depth,
+      std::function<void(const cav_msgs::BSM&)> publish, std::function<void(const std::exception&)> on_exception);
+
+    /**
+     * @brief Destructor, stops and joins the worker threads
+     */
+    ~BSMWorkerPool();
+
+    /**
+     * @brief Queue a message for conversion on the worker responsible for its sender
+     * 
+     * @param message The message to convert
+     */
+    void enqueue(const j2735_msgs::BSMConstPtr& message);
+
+    /**
+     * @brief Get the current queue depth and drop counters
+     */
+    Stats getStats();
+
+    /**
+     * @brief Stop the worker threads. Messages still queued are discarded
+     */
+    void stop();
+
+    /**
+     * @brief Get the index of the worker which handles messages with the given temporary id
+     * 
+     * @param id The temporary id of the sending vehicle
+     * @param num_workers The number of workers
+     */
+    static size_t workerFor(const std::vector<uint8_t>& id, size_t num_workers);
+
+  private:
+    struct Worker {
+      std::mutex mutex;
+      std::condition_variable ready;
+      std::deque<j2735_msgs::BSMConstPtr> queue; // Synchronized on mutex
+      size_t max_queue_depth = 0; // Synchronized on mutex
+      uint64_t converted = 0; // Synchronized on mutex
+      uint64_t dropped = 0; // Synchronized on mutex
+      std::thread thread;
+    };
+
+    const size_t max_queue_depth_;
+    std::function<void(const cav_msgs::BSM&)> publish_;
+    std::function<void(const std::exception&)> on_exception_;
+    std::atomic<bool> running_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    /**
+     * @brief Body of each worker thread
+     * 
+     * @param worker The worker whose queue this thread drains
+     */
+    void work(Worker& worker);
+};
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include "map_convertor.h"
+#include "spat_convertor.h"
+
+/**
+ * Offline benchmark for the MAP and SPAT convertors
+ * 
+ * Converts synthetic j2735 MAP and SPAT messages and reports the time and the number of heap allocations
+ * needed per converted message. Allocations are counted by replacing the global operator new. 
+ * No ROS master is needed.
+ * 
+ * Usage: j2735_convertor_benchmark [--intersections N] [--lanes N] [--nodes N] [--movements N] [--events N] [--messages N]
+ */
+
+namespace
+{
+  // Number of calls to the global operator new since start up
+  size_t allocation_count = 0;
+
+  void print_usage() {
+    std::cerr << "Usage: j2735_convertor_benchmark [--intersections N] [--lanes N] [--nodes N] "
+      << "[--movements N] [--events N] [--messages N]" << std::endl;
+  }
+
+  j2735_msgs::MapData buildMap(int intersections, int lanes, int nodes) {
+    j2735_msgs::MapData map;
+    map.intersections_exists = true;
+    for (int i = 0; i < intersections; i++) {
+      j2735_msgs::IntersectionGeometry geometry;
+      geometry.id.id = i;
+      geometry.revision = 1;
+      geometry.name = "intersection_" + std::to_string(i);
+      geometry.name_exists = true;
+      geometry.speed_limits.speed_limits.resize(1);
+      geometry.speed_limits_exists = true;
+      for (int l = 0; l < lanes; l++) {
+        j2735_msgs::GenericLane lane;
+        lane.lane_id = l;
+        lane.connects_to.connect_to_list.resize(2);
+        lane.connects_to_exists = true;
+        for (int n = 0; n < nodes; n++) {
+          j2735_msgs::NodeXY node;
+          node.delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_XY2;
+          node.delta.node_xy2.x = 100 * n;
+          node.delta.node_xy2.y = 50 * l;
+          node.attributes.data.lane_attribute_list.resize(1);
+          node.attributes.data.lane_attribute_list[0].choice = j2735_msgs::LaneDataAttribute::LANE_ANGLE;
+          node.attributes.data_exists = true;
+          node.attributes_exists = true;
+          lane.node_list.nodes.node_set_xy.push_back(node);
+        }
+        geometry.lane_set.lane_list.push_back(lane);
+      }
+      map.intersections.push_back(geometry);
+    }
+    return map;
+  }
+
+  j2735_msgs::SPAT buildSpat(int intersections, int movements, int events) {
+    j2735_msgs::SPAT spat;
+    for (int i = 0; i < intersections; i++) {
+      j2735_msgs::IntersectionState state;
+      state.id.id = i;
+      state.name = "intersection_" + std::to_string(i);
+      state.name_exists = true;
+      state.enabled_lanes.lane_id_list.resize(4);
+      for (int m = 0; m < movements; m++) {
+        j2735_msgs::MovementState movement;
+        movement.signal_group = m;
+        for (int e = 0; e < events; e++) {
+          j2735_msgs::MovementEvent event;
+          event.event_state.movement_phase_state = 3;
+          event.timing.min_end_time = 100 * e;
+          event.timing_exists = true;
+          event.speeds.advisory_speed_list.resize(1);
+          event.speeds_exists = true;
+          movement.state_time_speed.movement_event_list.push_back(event);
+        }
+        state.states.movement_list.push_back(movement);
+      }
+      spat.intersections.intersection_state_list.push_back(state);
+    }
+    return spat;
+  }
+
+  /**
+   * Runs the provided conversion the requested number of times and prints the mean time and allocations per message
+   */
+  template<class F>
+  void measure(const std::string& name, int messages, const F& convert) {
+    size_t start_allocations = allocation_count;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; i++) {
+      convert();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocations = allocation_count - start_allocations;
+
+    std::cout << std::left << std::fixed << std::setprecision(3)
+      << std::setw(12) << name
+      << std::setw(14) << 1e6 * elapsed / messages
+      << std::setw(14) << static_cast<double>(allocations) / messages << std::endl;
+  }
+}
+
+void* operator new(std::size_t size) {
+  allocation_count++;
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+int main(int argc, char** argv) {
+  int intersections = 1;
+  int lanes = 16;
+  int nodes = 12;
+  int movements = 16;
+  int events = 1;
+  int messages = 1000;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      print_usage();
+      return 1;
+    }
+    int value = std::stoi(argv[++i]);
+
+    if (arg == "--intersections") intersections = value;
+    else if (arg == "--lanes") lanes = value;
+    else if (arg == "--nodes") nodes = value;
+    else if (arg == "--movements") movements = value;
+    else if (arg == "--events") events = value;
+    else if (arg == "--messages") messages = value;
+    else {
+      print_usage();
+      return 1;
+    }
+  }
+
+  const j2735_msgs::MapData map = buildMap(intersections, lanes, nodes);
+  const j2735_msgs::SPAT spat = buildSpat(intersections, movements, events);
+  MapConversionCache map_cache;
+
+  std::cout << std::left 
+    << std::setw(12) << "message" 
+    << std::setw(14) << "us/msg" 
+    << std::setw(14) << "allocs/msg" << std::endl;
+
+  measure("map", messages, [&map]() {
+    cav_msgs::MapData out_msg;
+    MapConvertor::convert(map, out_msg);
+  });
+  measure("map_cached", messages, [&map, &map_cache]() {
+    cav_msgs::MapData out_msg;
+    MapConvertor::convert(map, out_msg, map_cache);
+  });
+  measure("spat", messages, [&spat]() {
+    cav_msgs::SPAT out_msg;
+    SPATConvertor::convert(spat, out_msg);
+  });
+
+  return 0;
+}
@@ -18,6 +18,7 @@
  * CPP File containing J2735Convertor method definitions
  */
 
+#include <algorithm>
 #include "j2735_convertor.h"
 
 int J2735Convertor::run() {
@@ -46,6 +47,11 @@ int J2735Convertor::run() {
     ros::spinOnce();
     r.sleep();
   }
+  // Stop BSM delivery before the pool it hands messages to is destroyed,
+  // then stop BSM conversion before the publishers it uses are torn down
+  bsm_spinner.stop();
+  bsm_worker_pool_.reset();
+
   // Request ros node shutdown before exit
   ros::shutdown();
 
@@ -63,8 +69,34 @@ void J2735Convertor::initialize() {
   spat_nh_->setCallbackQueue(&spat_queue_);
   map_nh_->setCallbackQueue(&map_queue_);
 
+  ros::NodeHandle pnh("~");
+  pnh.param("bsm_batch_size", bsm_batch_size_, bsm_batch_size_);
+  pnh.param("bsm_batch_period", bsm_batch_period_, bsm_batch_period_);
+  pnh.param("bsm_worker_threads", bsm_worker_threads_, bsm_worker_threads_);
+  pnh.param("bsm_worker_queue_size", bsm_worker_queue_size_, bsm_worker_queue_size_);
+  pnh.param("bsm_subscriber_queue_size", bsm_subscriber_queue_size_, bsm_subscriber_queue_size_);
+  pnh.param("bsm_metrics_period", bsm_metrics_period_, bsm_metrics_period_);
+  pnh.param("cache_map_conversions", cache_map_conversions_, cache_map_conversions_);
+  pnh.param("publish_spat_changes", publish_spat_changes_, publish_spat_changes_);
+  pnh.param("spat_snapshot_period", spat_snapshot_period_, spat_snapshot_period_);
+  pnh.param("spat_likely_time_tolerance", spat_tracker_.likely_time_tolerance, spat_tracker_.likely_time_tolerance);
+  pnh.param("decode_binary_messages", decode_binary_messages_, decode_binary_messages_);
+  pending_bsms_.reserve(bsm_batch_size_);
+
+  if (bsm_worker_threads_ > 1) {
+    // Workers drain everything queued for them at once so the batch timer is not needed
+    bsm_worker_pool_.reset(new BSMWorkerPool(bsm_worker_threads_, std::max(bsm_worker_queue_size_, 1),
+      [this](const cav_msgs::BSM& msg) { converted_bsm_pub_.publish(msg); },
+      [this](const std::exception& e) { handleException(e); }));
+    bsm_metrics_timer_ = default_nh_->createTimer(ros::Duration(bsm_metrics_period_), [this](const ros::TimerEvent&) { reportBsmMetrics(); });
+  }
+  else if (bsm_batch_size_ > 1) {
+    // Flushes partial batches so BSMs are never held longer than the batch period
+    bsm_batch_timer_ = bsm_nh_->createTimer(ros::Duration(bsm_batch_period_), [this](const ros::TimerEvent&) { convertPendingBsms(); });
+  }
+
   // J2735 BSM Subscriber
-  j2735_bsm_sub_ = bsm_nh_->subscribe("incoming_j2735_bsm", 100, &J2735Convertor::j2735BsmHandler, this);
+  j2735_bsm_sub_ = bsm_nh_->subscribe("incoming_j2735_bsm", bsm_subscriber_queue_size_, &J2735Convertor::j2735BsmHandler, this);
 
   // BSM Publisher
   converted_bsm_pub_ = bsm_nh_->advertise<cav_msgs::BSM>("incoming_bsm", 100);
@@ -81,12 +113,28 @@ void J2735Convertor::initialize() {
   // SPAT Publisher TODO think about queue sizes
   converted_spat_pub_ = spat_nh_->advertise<cav_msgs::SPAT>("incoming_spat", 100);
 
+  // SPAT Change Publisher
+  if (publish_spat_changes_) {
+    spat_changes_pub_ = spat_nh_->advertise<cav_msgs::SPAT>("incoming_spat_changes", 100);
+  }
+
   // J2735 MAP Subscriber
   j2735_map_sub_ = map_nh_->subscribe("incoming_j2735_map", 50, &J2735Convertor::j2735MapHandler, this);
 
   // MAP Publisher TODO think about queue sizes
   converted_map_pub_ = map_nh_->advertise<cav_msgs::MapData>("incoming_map", 50);
 
+  // Binary message Subscribers, one per message thread so each type is still decoded on its own queue
+  if (decode_binary_messages_) {
+#ifdef HAVE_J2735_CODEC
+    binary_bsm_sub_ = bsm_nh_->subscribe("inbound_binary_msg", bsm_subscriber_queue_size_, &J2735Convertor::binaryBsmHandler, this);
+    binary_spat_sub_ = spat_nh_->subscribe("inbound_binary_msg", 100, &J2735Convertor::binarySpatHandler, this);
+    binary_map_sub_ = map_nh_->subscribe("inbound_binary_msg", 50, &J2735Convertor::binaryMapHandler, this);
+#else
+    ROS_WARN_STREAM("decode_binary_messages is set but this node was built without the native J2735 codec, ignoring it");
+#endif
+  }
+
   // SystemAlert Subscriber
   system_alert_sub_ = default_nh_->subscribe("system_alert", 10, &J2735Convertor::systemAlertHandler, this);
 
@@ -106,21 +154,63 @@ void J2735Convertor::BsmHandler(const cav_msgs::BSMConstPtr& message) {
 }
 
 void J2735Convertor::j2735BsmHandler(const j2735_msgs::BSMConstPtr& message) {
+  if (bsm_worker_pool_) {
+    bsm_worker_pool_->enqueue(message);
+    return;
+  }
+  pending_bsms_.push_back(message);
+  if (pending_bsms_.size() >= (size_t)bsm_batch_size_) {
+    convertPendingBsms();
+  }
+}
+
+void J2735Convertor::convertPendingBsms() {
+  if (pending_bsms_.empty()) {
+    return;
+  }
   try {
-    cav_msgs::BSM converted_msg;
-    BSMConvertor::convert(*message, converted_msg); // Convert message
-    converted_bsm_pub_.publish(converted_msg); // Publish converted message
+    BSMConvertor::convert(pending_bsms_, converted_bsms_); // Convert messages
+    for (const cav_msgs::BSM& converted_msg : converted_bsms_) {
+      converted_bsm_pub_.publish(converted_msg); // Publish converted message
+    }
   }
   catch(const std::exception& e) {
     handleException(e);
   }
+  pending_bsms_.clear();
+}
+
+void J2735Convertor::reportBsmMetrics() {
+  BSMWorkerPool::Stats stats = bsm_worker_pool_->getStats();
+  ROS_DEBUG_STREAM("BSM workers converted: " << stats.converted << " queued: " << stats.queue_depth
+    << " max queued: " << stats.max_queue_depth << " dropped: " << stats.dropped);
+  if (stats.dropped > reported_bsm_drops_) {
+    ROS_WARN_STREAM("Dropped " << (stats.dropped - reported_bsm_drops_) << " incoming BSMs in the last " << bsm_metrics_period_
+      << " s, consider increasing bsm_worker_threads or bsm_worker_queue_size");
+    reported_bsm_drops_ = stats.dropped;
+  }
 }
 
 void J2735Convertor::j2735SpatHandler(const j2735_msgs::SPATConstPtr& message) {
   try {
     cav_msgs::SPAT converted_msg;
     SPATConvertor::convert(*message, converted_msg); // Convert message
-    converted_spat_pub_.publish(converted_msg); // Publish converted message
+    if (!publish_spat_changes_) {
+      converted_spat_pub_.publish(converted_msg); // Publish converted message
+      return;
+    }
+
+    cav_msgs::SPAT changes;
+    const bool changed = SPATConvertor::extractChanges(converted_msg, spat_tracker_, changes);
+    if (changed) {
+      spat_changes_pub_.publish(changes); // Publish changed movement states
+    }
+    // Unchanged repeats are only republished in full at the snapshot period
+    ros::Time now = ros::Time::now();
+    if (changed || now - last_spat_snapshot_ >= ros::Duration(spat_snapshot_period_)) {
+      converted_spat_pub_.publish(converted_msg); // Publish converted message
+      last_spat_snapshot_ = now;
+    }
   }
   catch(const std::exception& e) {
     handleException(e);
@@ -130,7 +220,11 @@ void J2735Convertor::j2735SpatHandler(const j2735_msgs::SPATConstPtr& message) {
 void J2735Convertor::j2735MapHandler(const j2735_msgs::MapDataConstPtr& message) {
   try {
     cav_msgs::MapData converted_msg;
-    MapConvertor::convert(*message, converted_msg); // Convert message
+    if (cache_map_conversions_) {
+      MapConvertor::convert(*message, converted_msg, map_cache_); // Convert changed intersections and road segments
+    } else {
+      MapConvertor::convert(*message, converted_msg); // Convert message
+    }
     converted_map_pub_.publish(converted_msg); // Publish converted message
   }
   catch(const std::exception& e) {
@@ -138,6 +232,44 @@ void J2735Convertor::j2735MapHandler(const j2735_msgs::MapDataConstPtr& message)
   }
 }
 
+#ifdef HAVE_J2735_CODEC
+void J2735Convertor::binaryBsmHandler(const cav_msgs::ByteArrayConstPtr& message) {
+  if (message->messageType != "BSM") {
+    return;
+  }
+  j2735_msgs::BSMPtr bsm = boost::make_shared<j2735_msgs::BSM>();
+  if (!UPERDecoder::decode(message->content, *bsm)) {
+    ROS_WARN_STREAM_THROTTLE(1, "Failed to decode inbound binary BSM");
+    return;
+  }
+  j2735BsmHandler(bsm);
+}
+
+void J2735Convertor::binarySpatHandler(const cav_msgs::ByteArrayConstPtr& message) {
+  if (message->messageType != "SPAT") {
+    return;
+  }
+  j2735_msgs::SPATPtr spat = boost::make_shared<j2735_msgs::SPAT>();
+  if (!UPERDecoder::decode(message->content, *spat)) {
+    ROS_WARN_STREAM_THROTTLE(1, "Failed to decode inbound binary SPAT");
+    return;
+  }
+  j2735SpatHandler(spat);
+}
+
+void J2735Convertor::binaryMapHandler(const cav_msgs::ByteArrayConstPtr& message) {
+  if (message->messageType != "MAP") {
+    return;
+  }
+  j2735_msgs::MapDataPtr map = boost::make_shared<j2735_msgs::MapData>();
+  if (!UPERDecoder::decode(message->content, *map)) {
+    ROS_WARN_STREAM_THROTTLE(1, "Failed to decode inbound binary MAP");
+    return;
+  }
+  j2735MapHandler(map);
+}
+#endif
+
 void J2735Convertor::systemAlertHandler(const cav_msgs::SystemAlertConstPtr& message) {
   try {
     ROS_INFO_STREAM("Received SystemAlert message of type: " << message->type);
@@ -16,6 +16,7 @@
  */
 
 #include <mutex>
+#include <vector>
 #include <ros/ros.h>
 #include <ros/callback_queue.h>
 #include <j2735_msgs/BSM.h>
@@ -28,6 +29,11 @@
 #include "bsm_convertor.h"
 #include "map_convertor.h"
 #include "spat_convertor.h"
+#include "bsm_worker_pool.h"
+#ifdef HAVE_J2735_CODEC
+#include <cav_msgs/ByteArray.h>
+#include "uper_decoder.h"
+#endif
 
 /**
  * @class J2735Convertor
@@ -37,7 +43,11 @@
  * The j2735_msgs are then converted to cav_msgs types including any necessary unit conversions. 
  * 
  * Each j2735 topic has its own thread for processing. This will help prevent larger message types like Map from blocking
- * small high frequency message types like BSMs.
+ * small high frequency message types like BSMs. When bsm_worker_threads is greater than 1 incoming BSMs are instead handed
+ * to a BSMWorkerPool which converts them in parallel while keeping the messages of each sender in order.
+ * 
+ * When decode_binary_messages is set and the node was built against a libasn1c which provides the native codec, BSM, SPAT and MAP
+ * messages are decoded directly from inbound_binary_msg on their own threads instead of being received pre-decoded from the message node.
  * 
  * Other subscribed topics like system_alert are handled on the default global queue
  *
@@ -52,8 +62,9 @@ private:
     bool shutting_down_ = false;
     // Members used in ROS behavior
     int default_spin_rate_ = 10;
-    ros::Publisher converted_bsm_pub_, converted_spat_pub_, converted_map_pub_, system_alert_pub_, outbound_j2735_bsm_pub_;
+    ros::Publisher converted_bsm_pub_, converted_spat_pub_, spat_changes_pub_, converted_map_pub_, system_alert_pub_, outbound_j2735_bsm_pub_;
     ros::Subscriber j2735_bsm_sub_, j2735_spat_sub_, j2735_map_sub_, system_alert_sub_, outbound_bsm_sub_;
+    ros::Subscriber binary_bsm_sub_, binary_spat_sub_, binary_map_sub_;
     std::shared_ptr<ros::NodeHandle> default_nh_;
     std::shared_ptr<ros::NodeHandle> bsm_nh_;
     std::shared_ptr<ros::NodeHandle> spat_nh_;
@@ -61,6 +72,32 @@ private:
     ros::CallbackQueue bsm_queue_;
     ros::CallbackQueue spat_queue_;
     ros::CallbackQueue map_queue_;
+    // Incoming BSMs are converted in batches of up to bsm_batch_size_ or whatever arrived within bsm_batch_period_.
+    // Only accessed from the bsm_queue_ thread
+    int bsm_batch_size_ = 1;
+    double bsm_batch_period_ = 0.01;
+    ros::Timer bsm_batch_timer_;
+    std::vector<j2735_msgs::BSMConstPtr> pending_bsms_;
+    std::vector<cav_msgs::BSM> converted_bsms_;
+    // Incoming BSMs are converted on bsm_worker_threads_ threads when more than one is requested
+    int bsm_worker_threads_ = 1;
+    int bsm_worker_queue_size_ = 100;
+    int bsm_subscriber_queue_size_ = 100;
+    double bsm_metrics_period_ = 5.0;
+    std::unique_ptr<BSMWorkerPool> bsm_worker_pool_;
+    ros::Timer bsm_metrics_timer_;
+    uint64_t reported_bsm_drops_ = 0;
+    // Converted intersections and road segments reused across MAP messages. Only accessed from the map_queue_ thread
+    bool cache_map_conversions_ = false;
+    MapConversionCache map_cache_;
+    // When enabled only changed movement states are published on incoming_spat_changes and full SPATs on incoming_spat
+    // are sent when something changed or at least every spat_snapshot_period_. Only accessed from the spat_queue_ thread
+    bool publish_spat_changes_ = false;
+    double spat_snapshot_period_ = 1.0;
+    SPATChangeTracker spat_tracker_;
+    ros::Time last_spat_snapshot_;
+    // When enabled BSM, SPAT and MAP messages are decoded from inbound_binary_msg by this node
+    bool decode_binary_messages_ = false;
 public:
   /**
    * @brief Constructor
@@ -97,6 +134,16 @@ private:
    */
   void j2735BsmHandler(const j2735_msgs::BSMConstPtr& message);
 
+  /**
+   * @brief Converts all pending j2735_msgs::BSM messages to cav_msgs::BSM in one batch and publishes the converted messages
+   */
+  void convertPendingBsms();
+
+  /**
+   * @brief Logs the queue depth and drop counters of the BSM worker pool
+   */
+  void reportBsmMetrics();
+
   /**
    * @brief Converts j2735_msgs::SPAT messages to cav_msgs::SPAT and publishes the converted messages
    * 
@@ -111,6 +158,29 @@ private:
    */
   void j2735MapHandler(const j2735_msgs::MapDataConstPtr& message);
 
+#ifdef HAVE_J2735_CODEC
+  /**
+   * @brief Decodes inbound binary BSMs and passes them on to j2735BsmHandler
+   * 
+   * @param message The inbound binary message, messages of other types are ignored
+   */
+  void binaryBsmHandler(const cav_msgs::ByteArrayConstPtr& message);
+
+  /**
+   * @brief Decodes inbound binary SPATs and passes them on to j2735SpatHandler
+   * 
+   * @param message The inbound binary message, messages of other types are ignored
+   */
+  void binarySpatHandler(const cav_msgs::ByteArrayConstPtr& message);
+
+  /**
+   * @brief Decodes inbound binary MAPs and passes them on to j2735MapHandler
+   * 
+   * @param message The inbound binary message, messages of other types are ignored
+   */
+  void binaryMapHandler(const cav_msgs::ByteArrayConstPtr& message);
+#endif
+
   /**
    * @brief Handles incoming SystemAlert messages
    * 
@@ -107,10 +107,10 @@ void MapConvertor::convertLaneDataAttribute(const j2735_msgs::LaneDataAttribute&
       break;
     case j2735_msgs::LaneDataAttribute::SPEED_LIMITS:
         // Convert SpeedLimitsList
-        for (j2735_msgs::RegulatorySpeedLimit limit : in_msg.speed_limits.speed_limits) {
-          cav_msgs::RegulatorySpeedLimit cav_limit;
-          convertRegulatorySpeedLimit(limit, cav_limit);
-          out_msg.speed_limits.push_back(cav_limit);
+        out_msg.speed_limits.reserve(in_msg.speed_limits.speed_limits.size());
+        for (const j2735_msgs::RegulatorySpeedLimit& limit : in_msg.speed_limits.speed_limits) {
+          out_msg.speed_limits.emplace_back();
+          convertRegulatorySpeedLimit(limit, out_msg.speed_limits.back());
         }
       break;
   }
@@ -118,20 +118,13 @@ void MapConvertor::convertLaneDataAttribute(const j2735_msgs::LaneDataAttribute&
 }
 
 void MapConvertor::convertNodeAttributeSetXY(const j2735_msgs::NodeAttributeSetXY& in_msg, cav_msgs::NodeAttributeSetXY& out_msg) {
-  for (j2735_msgs::NodeAttributeXY attribute : in_msg.local_node.node_attribute_xy_List) {
-    out_msg.local_node.push_back(attribute);
-  }
+  out_msg.local_node = in_msg.local_node.node_attribute_xy_List;
   out_msg.local_node_exists = in_msg.local_node_exists;
 
-  for (j2735_msgs::SegmentAttributeXY attribute : in_msg.disabled.segment_attribute_xy) {
-    out_msg.disabled.push_back(attribute);
-  }
+  out_msg.disabled = in_msg.disabled.segment_attribute_xy;
   out_msg.disabled_exists = in_msg.disabled_exists;
 
-
-  for (j2735_msgs::SegmentAttributeXY attribute : in_msg.enabled.segment_attribute_xy) {
-    out_msg.enabled.push_back(attribute);
-  }
+  out_msg.enabled = in_msg.enabled.segment_attribute_xy;
   out_msg.enabled_exists = in_msg.enabled_exists;
 
   out_msg.data_exists = in_msg.data_exists;
@@ -139,10 +132,10 @@ void MapConvertor::convertNodeAttributeSetXY(const j2735_msgs::NodeAttributeSetX
   out_msg.dElevation_exists = in_msg.dElevation_exists;
   
   // Convert LaneDataAttributeList
-  for (j2735_msgs::LaneDataAttribute attribute : in_msg.data.lane_attribute_list) {
-    cav_msgs::LaneDataAttribute cav_attribute;
-    convertLaneDataAttribute(attribute, cav_attribute);
-    out_msg.lane_attribute_list.push_back(cav_attribute);
+  out_msg.lane_attribute_list.reserve(in_msg.data.lane_attribute_list.size());
+  for (const j2735_msgs::LaneDataAttribute& attribute : in_msg.data.lane_attribute_list) {
+    out_msg.lane_attribute_list.emplace_back();
+    convertLaneDataAttribute(attribute, out_msg.lane_attribute_list.back());
   }
   // Convert dWidth
   out_msg.dWitdh = (double)in_msg.dWitdh / units::CM_PER_M;
@@ -158,10 +151,10 @@ void MapConvertor::convertNodeXY(const j2735_msgs::NodeXY& in_msg, cav_msgs::Nod
 }
 
 void MapConvertor::convertNodeSetXY(const j2735_msgs::NodeSetXY& in_msg, cav_msgs::NodeSetXY& out_msg) {
-  for (j2735_msgs::NodeXY node: in_msg.node_set_xy) {
-    cav_msgs::NodeXY cav_node;
-    convertNodeXY(node, cav_node);
-    out_msg.node_set_xy.push_back(cav_node);
+  out_msg.node_set_xy.reserve(in_msg.node_set_xy.size());
+  for (const j2735_msgs::NodeXY& node : in_msg.node_set_xy) {
+    out_msg.node_set_xy.emplace_back();
+    convertNodeXY(node, out_msg.node_set_xy.back());
   }
 }
 
@@ -224,16 +217,16 @@ void MapConvertor::convertIntersectionGeometry(const j2735_msgs::IntersectionGeo
   // Convert LaneWidth
   out_msg.lane_width = (double)in_msg.lane_width / units::CM_PER_M;
   // Convert SpeedLimitsList
-  for (j2735_msgs::RegulatorySpeedLimit limit : in_msg.speed_limits.speed_limits) {
-    cav_msgs::RegulatorySpeedLimit cav_limit;
-    convertRegulatorySpeedLimit(limit, cav_limit);
-    out_msg.speed_limits.push_back(cav_limit);
+  out_msg.speed_limits.reserve(in_msg.speed_limits.speed_limits.size());
+  for (const j2735_msgs::RegulatorySpeedLimit& limit : in_msg.speed_limits.speed_limits) {
+    out_msg.speed_limits.emplace_back();
+    convertRegulatorySpeedLimit(limit, out_msg.speed_limits.back());
   }
   // Convert RoadLaneSet
-  for (j2735_msgs::GenericLane lane : in_msg.lane_set.lane_list) {
-    cav_msgs::GenericLane cav_lane;
-    convertGenericLane(lane, cav_lane);
-    out_msg.lane_list.push_back(cav_lane);
+  out_msg.lane_list.reserve(in_msg.lane_set.lane_list.size());
+  for (const j2735_msgs::GenericLane& lane : in_msg.lane_set.lane_list) {
+    out_msg.lane_list.emplace_back();
+    convertGenericLane(lane, out_msg.lane_list.back());
   }
   // Done Convertion
 
@@ -254,23 +247,35 @@ void MapConvertor::convertRoadSegment(const j2735_msgs::RoadSegment& in_msg, cav
   // Done Convertion
   out_msg.lane_width_exists = in_msg.lane_width_exists;
   // Convert SpeedLimitList
-  for (j2735_msgs::RegulatorySpeedLimit limit : in_msg.speed_limits.speed_limits) {
-    cav_msgs::RegulatorySpeedLimit cav_limit;
-    convertRegulatorySpeedLimit(limit, cav_limit);
-    out_msg.speed_limits.push_back(cav_limit);
+  out_msg.speed_limits.reserve(in_msg.speed_limits.speed_limits.size());
+  for (const j2735_msgs::RegulatorySpeedLimit& limit : in_msg.speed_limits.speed_limits) {
+    out_msg.speed_limits.emplace_back();
+    convertRegulatorySpeedLimit(limit, out_msg.speed_limits.back());
   }
   // Done Convertion
   out_msg.speed_limits_exists = in_msg.speed_limits_exists;
   // Convert RoadLaneSet
-  for (j2735_msgs::GenericLane lane : in_msg.road_lane_set.road_lane_set_list) {
-    cav_msgs::GenericLane cav_lane;
-    convertGenericLane(lane, cav_lane);
-    out_msg.road_lane_set_list.push_back(cav_lane);
+  out_msg.road_lane_set_list.reserve(in_msg.road_lane_set.road_lane_set_list.size());
+  for (const j2735_msgs::GenericLane& lane : in_msg.road_lane_set.road_lane_set_list) {
+    out_msg.road_lane_set_list.emplace_back();
+    convertGenericLane(lane, out_msg.road_lane_set_list.back());
   }
   // Done Convertion
 }
 
+uint32_t MapConvertor::cacheKey(uint16_t region, uint16_t id) {
+  return ((uint32_t)region << 16) | id;
+}
+
 void MapConvertor::convert(const j2735_msgs::MapData& in_msg, cav_msgs::MapData& out_msg) {
+  convertMapData(in_msg, out_msg, nullptr);
+}
+
+void MapConvertor::convert(const j2735_msgs::MapData& in_msg, cav_msgs::MapData& out_msg, MapConversionCache& cache) {
+  convertMapData(in_msg, out_msg, &cache);
+}
+
+void MapConvertor::convertMapData(const j2735_msgs::MapData& in_msg, cav_msgs::MapData& out_msg, MapConversionCache* cache) {
   out_msg.header = in_msg.header;
   out_msg.time_stamp = in_msg.time_stamp;
   out_msg.time_stamp_exists = in_msg.time_stamp_exists;
@@ -281,20 +286,52 @@ void MapConvertor::convert(const j2735_msgs::MapData& in_msg, cav_msgs::MapData&
   out_msg.intersections_exists = in_msg.intersections_exists;
   
   // Convert IntersectionGeometryList
-  for (j2735_msgs::IntersectionGeometry geometry : in_msg.intersections) {
-    cav_msgs::IntersectionGeometry cav_geometry;
-    convertIntersectionGeometry(geometry, cav_geometry);
-    out_msg.intersections.push_back(cav_geometry);
+  out_msg.intersections.reserve(in_msg.intersections.size());
+  for (const j2735_msgs::IntersectionGeometry& geometry : in_msg.intersections) {
+    if (!cache) {
+      out_msg.intersections.emplace_back();
+      convertIntersectionGeometry(geometry, out_msg.intersections.back());
+      continue;
+    }
+    // Reuse the cached conversion while the revision is unchanged
+    const uint32_t key = cacheKey(geometry.id.region, geometry.id.id);
+    auto cached = cache->intersections.find(key);
+    if (cached == cache->intersections.end() || cached->second.revision != geometry.revision) {
+      cav_msgs::IntersectionGeometry& entry = cache->intersections[key];
+      entry = cav_msgs::IntersectionGeometry();
+      convertIntersectionGeometry(geometry, entry);
+      out_msg.intersections.push_back(entry);
+      cache->misses++;
+    } else {
+      out_msg.intersections.push_back(cached->second);
+      cache->hits++;
+    }
   }
   // Done Conversion
   
   out_msg.road_segments_exists = in_msg.road_segments_exists;
   
   // Convert RoadSegmentList
-  for (j2735_msgs::RoadSegment seg : in_msg.road_segments.road_segment_list) {
-    cav_msgs::RoadSegment cav_seg;
-    convertRoadSegment(seg, cav_seg);
-    out_msg.road_segment_list.push_back(cav_seg);
+  out_msg.road_segment_list.reserve(in_msg.road_segments.road_segment_list.size());
+  for (const j2735_msgs::RoadSegment& seg : in_msg.road_segments.road_segment_list) {
+    if (!cache) {
+      out_msg.road_segment_list.emplace_back();
+      convertRoadSegment(seg, out_msg.road_segment_list.back());
+      continue;
+    }
+    // Reuse the cached conversion while the revision is unchanged
+    const uint32_t key = cacheKey(seg.id.region, seg.id.id);
+    auto cached = cache->road_segments.find(key);
+    if (cached == cache->road_segments.end() || cached->second.revision != seg.revision) {
+      cav_msgs::RoadSegment& entry = cache->road_segments[key];
+      entry = cav_msgs::RoadSegment();
+      convertRoadSegment(seg, entry);
+      out_msg.road_segment_list.push_back(entry);
+      cache->misses++;
+    } else {
+      out_msg.road_segment_list.push_back(cached->second);
+      cache->hits++;
+    }
   }
   // Done Conversion
 
@@ -24,8 +24,23 @@
 #include <cav_msgs/BSM.h>
 #include <cav_msgs/SPAT.h>
 #include <cav_msgs/MapData.h>
+#include <cstdint>
+#include <unordered_map>
 #include "units.h"
 
+/**
+ * @brief Intersections and road segments converted from earlier MAP messages
+ * 
+ * Entries are keyed by region and id and reused while the incoming element carries the same revision.
+ * J2735 requires the revision to be incremented whenever the content of an intersection or road segment changes.
+ */
+struct MapConversionCache {
+  std::unordered_map<uint32_t, cav_msgs::IntersectionGeometry> intersections;
+  std::unordered_map<uint32_t, cav_msgs::RoadSegment> road_segments;
+  uint64_t hits = 0; // Number of elements reused
+  uint64_t misses = 0; // Number of elements converted
+};
+
 /**
  * @class MAPConvertor
  * @brief Is the class responsible for converting J2735 Maps to CARMA usable Mapss
@@ -48,6 +63,17 @@ class MapConvertor
      */
     static void convert(const j2735_msgs::MapData& in_msg, cav_msgs::MapData& out_msg);
 
+    /**
+     * @brief Convert the contents of a j2735_msgs::MapData into a cav_msgs::MapData reusing unchanged elements
+     * 
+     * @param in_msg The message to be converted
+     * @param out_msg The message to store the output
+     * @param cache Previously converted intersections and road segments. Updated with any element which was converted
+     * 
+     * Intersections and road segments whose id and revision match a cache entry are copied from the cache instead of being converted
+     */
+    static void convert(const j2735_msgs::MapData& in_msg, cav_msgs::MapData& out_msg, MapConversionCache& cache);
+
   private:
 
     /**
@@ -189,4 +215,21 @@ class MapConvertor
      * Unit conversions are handled
      */
     static void convertRoadSegment(const j2735_msgs::RoadSegment& in_msg, cav_msgs::RoadSegment& out_msg);
+
+    /**
+     * @brief Convert a j2735_msgs::MapData using the conversion cache if one is provided
+     * 
+     * @param in_msg The message to be converted
+     * @param out_msg The message to store the output
+     * @param cache The conversion cache or nullptr if every element should be converted
+     */
+    static void convertMapData(const j2735_msgs::MapData& in_msg, cav_msgs::MapData& out_msg, MapConversionCache* cache);
+
+    /**
+     * @brief Get the cache key for an intersection or road segment reference id
+     * 
+     * @param region The region of the reference id
+     * @param id The id within the region
+     */
+    static uint32_t cacheKey(uint16_t region, uint16_t id);
 };  
@@ -18,6 +18,7 @@
  * CPP File containing SPATConvertor method definitions
  */
 
+#include <cmath>
 #include "spat_convertor.h"
 
 void SPATConvertor::convertTimeChangeDetails(const j2735_msgs::TimeChangeDetails& in_msg, cav_msgs::TimeChangeDetails& out_msg) {
@@ -58,10 +59,10 @@ void SPATConvertor::convertMovementEvent(const j2735_msgs::MovementEvent& in_msg
 
   out_msg.speeds_exists = in_msg.speeds_exists;
   // Convert AdvisorySpeedList
-    for (j2735_msgs::AdvisorySpeed speed : in_msg.speeds.advisory_speed_list) {
-    cav_msgs::AdvisorySpeed cav_speed;
-    convertAdvisorySpeed(speed, cav_speed);
-    out_msg.advisory_speed_list.push_back(cav_speed);
+  out_msg.advisory_speed_list.reserve(in_msg.speeds.advisory_speed_list.size());
+  for (const j2735_msgs::AdvisorySpeed& speed : in_msg.speeds.advisory_speed_list) {
+    out_msg.advisory_speed_list.emplace_back();
+    convertAdvisorySpeed(speed, out_msg.advisory_speed_list.back());
   }
 }
 
@@ -70,10 +71,10 @@ void SPATConvertor::convertMovementState(const j2735_msgs::MovementState& in_msg
   out_msg.movement_name_exists = in_msg.movement_name_exists;
   out_msg.signal_group = in_msg.signal_group;
   // Convert MovementEvent
-  for (j2735_msgs::MovementEvent event : in_msg.state_time_speed.movement_event_list) {
-    cav_msgs::MovementEvent cav_event;
-    convertMovementEvent(event, cav_event);
-    out_msg.movement_event_list.push_back(cav_event);
+  out_msg.movement_event_list.reserve(in_msg.state_time_speed.movement_event_list.size());
+  for (const j2735_msgs::MovementEvent& event : in_msg.state_time_speed.movement_event_list) {
+    out_msg.movement_event_list.emplace_back();
+    convertMovementEvent(event, out_msg.movement_event_list.back());
   }
   // Done Conversion
   out_msg.connection_maneuver_assist_list = in_msg.maneuver_assist_list.connection_maneuver_assist_list;
@@ -96,10 +97,10 @@ void SPATConvertor::convertIntersectionState(const j2735_msgs::IntersectionState
   out_msg.enabled_lanes_exists = in_msg.enabled_lanes_exists;
 
   // Convert MovementState
-  for (j2735_msgs::MovementState state : in_msg.states.movement_list) {
-    cav_msgs::MovementState cav_state;
-    convertMovementState(state, cav_state);
-    out_msg.movement_list.push_back(cav_state);
+  out_msg.movement_list.reserve(in_msg.states.movement_list.size());
+  for (const j2735_msgs::MovementState& state : in_msg.states.movement_list) {
+    out_msg.movement_list.emplace_back();
+    convertMovementState(state, out_msg.movement_list.back());
   }
   // Done Conversion
 
@@ -114,10 +115,81 @@ void SPATConvertor::convert(const j2735_msgs::SPAT& in_msg, cav_msgs::SPAT& out_
   out_msg.name_exists = in_msg.name_exists;
 
   // Convert Intersection State List
-  for (j2735_msgs::IntersectionState state : in_msg.intersections.intersection_state_list) {
-    cav_msgs::IntersectionState cav_state;
-    convertIntersectionState(state, cav_state);
-    out_msg.intersection_state_list.push_back(cav_state);
+  out_msg.intersection_state_list.reserve(in_msg.intersections.intersection_state_list.size());
+  for (const j2735_msgs::IntersectionState& state : in_msg.intersections.intersection_state_list) {
+    out_msg.intersection_state_list.emplace_back();
+    convertIntersectionState(state, out_msg.intersection_state_list.back());
   }
 }
 
+
+bool SPATConvertor::movementChanged(const cav_msgs::MovementState& previous, const cav_msgs::MovementState& current, double likely_time_tolerance) {
+  if (previous.movement_event_list.size() != current.movement_event_list.size()) {
+    return true;
+  }
+  for (size_t i = 0; i < current.movement_event_list.size(); i++) {
+    const cav_msgs::MovementEvent& a = previous.movement_event_list[i];
+    const cav_msgs::MovementEvent& b = current.movement_event_list[i];
+    if (a.event_state.movement_phase_state != b.event_state.movement_phase_state || a.timing_exists != b.timing_exists
+      || a.timing.start_time != b.timing.start_time || a.timing.min_end_time != b.timing.min_end_time
+      || a.timing.max_end_time != b.timing.max_end_time || a.timing.next_time != b.timing.next_time
+      || std::fabs(a.timing.likely_time - b.timing.likely_time) > likely_time_tolerance) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SPATConvertor::extractChanges(const cav_msgs::SPAT& spat, SPATChangeTracker& tracker, cav_msgs::SPAT& changes) {
+  changes.time_stamp = spat.time_stamp;
+  changes.time_stamp_exists = spat.time_stamp_exists;
+  changes.name = spat.name;
+  changes.name_exists = spat.name_exists;
+
+  for (const cav_msgs::IntersectionState& state : spat.intersection_state_list) {
+    const uint32_t key = ((uint32_t)state.id.region << 16) | state.id.id;
+    auto record = tracker.intersections.find(key);
+    const bool first_seen = record == tracker.intersections.end();
+    if (first_seen) {
+      record = tracker.intersections.emplace(key, SPATChangeTracker::IntersectionRecord()).first;
+    }
+
+    // The intersection is only added to the output once something in it has changed
+    cav_msgs::IntersectionState* delta = nullptr;
+    auto addDelta = [&]() {
+      changes.intersection_state_list.emplace_back();
+      delta = &changes.intersection_state_list.back();
+      delta->name = state.name;
+      delta->name_exists = state.name_exists;
+      delta->id = state.id;
+      delta->revision = state.revision;
+      delta->status = state.status;
+      delta->moy = state.moy;
+      delta->moy_exists = state.moy_exists;
+      delta->time_stamp = state.time_stamp;
+      delta->time_stamp_exists = state.time_stamp_exists;
+      delta->lane_id_list = state.lane_id_list;
+      delta->enabled_lanes_exists = state.enabled_lanes_exists;
+      delta->connection_maneuver_assist_list = state.connection_maneuver_assist_list;
+      delta->maneuever_assist_list_exists = state.maneuever_assist_list_exists;
+    };
+
+    if (first_seen || record->second.status != state.status.intersection_status_object) {
+      addDelta();
+      record->second.status = state.status.intersection_status_object;
+    }
+
+    for (const cav_msgs::MovementState& movement : state.movement_list) {
+      auto previous = record->second.movements.find(movement.signal_group);
+      if (previous != record->second.movements.end() && !movementChanged(previous->second, movement, tracker.likely_time_tolerance)) {
+        continue;
+      }
+      if (!delta) {
+        addDelta();
+      }
+      delta->movement_list.push_back(movement);
+      record->second.movements[movement.signal_group] = movement;
+    }
+  }
+  return !changes.intersection_state_list.empty();
+}
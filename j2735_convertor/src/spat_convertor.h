@@ -24,8 +24,24 @@
 #include <cav_msgs/BSM.h>
 #include <cav_msgs/SPAT.h>
 #include <cav_msgs/MapData.h>
+#include <cstdint>
+#include <unordered_map>
 #include "units.h"
 
+/**
+ * @brief The last published movement states of each intersection, used to find changes between SPAT messages
+ */
+struct SPATChangeTracker {
+  struct IntersectionRecord {
+    uint16_t status = 0;
+    std::unordered_map<uint8_t, cav_msgs::MovementState> movements; // Keyed by signal group
+  };
+  std::unordered_map<uint32_t, IntersectionRecord> intersections; // Keyed by region and id
+  // Predicted phase end times which moved by no more than this many seconds do not count as a change,
+  // actuated controllers revise them on every broadcast
+  double likely_time_tolerance = 1.0;
+};
+
 /**
  * @class SPATConvertor
  * @brief Is the class responsible for converting J2735 SPATs to CARMA usable SPATs
@@ -47,6 +63,21 @@ class SPATConvertor
      */
     static void convert(const j2735_msgs::SPAT& in_msg, cav_msgs::SPAT& out_msg);
 
+    /**
+     * @brief Find the movement states which changed since they were last seen by the tracker
+     * 
+     * @param spat A converted SPAT message
+     * @param tracker The previously seen intersection states. Updated with the contents of spat
+     * @param changes The message to store the output. Holds only the intersections whose status or movement states changed
+     * and within them only the changed movement states
+     * 
+     * @return True if any intersection changed
+     * 
+     * A movement state has changed when its event states or timing differ, ignoring the confidence and changes of likely_time within
+     * the tracker's likely_time_tolerance. Intersections seen for the first time are reported in full
+     */
+    static bool extractChanges(const cav_msgs::SPAT& spat, SPATChangeTracker& tracker, cav_msgs::SPAT& changes);
+
   private:
     
     /**
@@ -98,4 +129,13 @@ class SPATConvertor
      * Unit conversions are handled
      */
     static void convertIntersectionState(const j2735_msgs::IntersectionState& in_msg, cav_msgs::IntersectionState& out_msg);
+
+    /**
+     * @brief Check if the event states or timing of a movement differ between two messages
+     * 
+     * @param previous The previously seen movement state
+     * @param current The newly received movement state
+     * @param likely_time_tolerance The change of likely_time in seconds below which it is considered unchanged
+     */
+    static bool movementChanged(const cav_msgs::MovementState& previous, const cav_msgs::MovementState& current, double likely_time_tolerance);
 };  
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * CPP File containing UPERDecoder method definitions
+ */
+
+#include <memory>
+#include <j2735_codec.h>
+#include "uper_decoder.h"
+
+namespace {
+  // The codec output structures are too large for the stack so each thread reuses its own instance
+  template<typename T>
+  T& scratch() {
+    static thread_local std::unique_ptr<T> instance(new T());
+    return *instance;
+  }
+
+  // Each node offset choice has its own message type in j2735_msgs, all of them hold x and y
+  template<typename T>
+  void setNodeOffset(const j2735_node_t& in_node, T& offset) {
+    offset.x = in_node.x;
+    offset.y = in_node.y;
+  }
+}
+
+bool UPERDecoder::decode(const std::vector<uint8_t>& data, j2735_msgs::BSM& out_msg) {
+  j2735_bsm_core_t bsm;
+  if (j2735_decode_bsm(data.data(), data.size(), &bsm) != 0) {
+    return false;
+  }
+  j2735_msgs::BSMCoreData& core = out_msg.core_data;
+  core.msg_count = bsm.msg_count;
+  core.id.assign(bsm.id, bsm.id + sizeof(bsm.id));
+  core.sec_mark = bsm.sec_mark;
+  core.latitude = bsm.latitude;
+  core.longitude = bsm.longitude;
+  core.elev = bsm.elevation;
+  core.accuracy.semiMajor = bsm.semi_major;
+  core.accuracy.semiMinor = bsm.semi_minor;
+  core.accuracy.orientation = bsm.orientation;
+  core.transmission.transmission_state = bsm.transmission;
+  core.speed = bsm.speed;
+  core.heading = bsm.heading;
+  core.angle = bsm.angle;
+  core.accelSet.longitudinal = bsm.accel_longitudinal;
+  core.accelSet.lateral = bsm.accel_lateral;
+  core.accelSet.vert = bsm.accel_vert;
+  core.accelSet.yaw_rate = bsm.accel_yaw_rate;
+  core.brakes.wheelBrakes.brake_applied_status = bsm.wheel_brakes;
+  core.brakes.traction.traction_control_status = bsm.traction;
+  core.brakes.abs.anti_lock_brake_status = bsm.abs;
+  core.brakes.scs.stability_control_status = bsm.scs;
+  core.brakes.brakeBoost.brake_boost_applied = bsm.brake_boost;
+  core.brakes.auxBrakes.auxiliary_brake_status = bsm.aux_brakes;
+  core.size.vehicle_width = bsm.vehicle_width;
+  core.size.vehicle_length = bsm.vehicle_length;
+  out_msg.header.frame_id = "MessageConsumer";
+  out_msg.header.stamp = ros::Time::now();
+  return true;
+}
+
+bool UPERDecoder::decode(const std::vector<uint8_t>& data, j2735_msgs::SPAT& out_msg) {
+  j2735_spat_t& spat = scratch<j2735_spat_t>();
+  if (j2735_decode_spat(data.data(), data.size(), &spat) != 0) {
+    return false;
+  }
+  out_msg.time_stamp_exists = spat.time_stamp_exists;
+  if (out_msg.time_stamp_exists) {
+    out_msg.time_stamp = spat.time_stamp;
+  }
+  out_msg.intersections.intersection_state_list.clear();
+  out_msg.intersections.intersection_state_list.emplace_back();
+  j2735_msgs::IntersectionState& intersection = out_msg.intersections.intersection_state_list.back();
+  intersection.id.id = spat.intersection_id;
+  intersection.revision = spat.revision;
+  intersection.moy_exists = spat.moy_exists;
+  if (intersection.moy_exists) {
+    intersection.moy = spat.moy;
+  }
+  intersection.time_stamp_exists = spat.intersection_time_stamp_exists;
+  if (intersection.time_stamp_exists) {
+    intersection.time_stamp = spat.intersection_time_stamp;
+  }
+  intersection.states.movement_list.reserve(spat.state_count);
+  for (uint16_t i = 0; i < spat.state_count; i++) {
+    const j2735_movement_state_t& in_state = spat.states[i];
+    intersection.states.movement_list.emplace_back();
+    j2735_msgs::MovementState& state = intersection.states.movement_list.back();
+    state.signal_group = in_state.signal_group;
+    state.state_time_speed.movement_event_list.reserve(in_state.event_count);
+    for (uint8_t j = 0; j < in_state.event_count; j++) {
+      const j2735_movement_event_t& in_event = in_state.events[j];
+      state.state_time_speed.movement_event_list.emplace_back();
+      j2735_msgs::MovementEvent& event = state.state_time_speed.movement_event_list.back();
+      event.event_state.movement_phase_state = in_event.event_state;
+      event.timing_exists = in_event.timing_exists;
+      if (!event.timing_exists) {
+        continue;
+      }
+      event.timing.start_time_exists = in_event.start_time_exists;
+      if (event.timing.start_time_exists) {
+        event.timing.start_time = in_event.start_time;
+      }
+      event.timing.min_end_time = in_event.min_end_time;
+      event.timing.max_end_time_exists = in_event.max_end_time_exists;
+      if (event.timing.max_end_time_exists) {
+        event.timing.max_end_time = in_event.max_end_time;
+      }
+      event.timing.next_time_exists = in_event.next_time_exists;
+      if (event.timing.next_time_exists) {
+        event.timing.next_time = in_event.next_time;
+      }
+    }
+  }
+  return true;
+}
+
+bool UPERDecoder::decode(const std::vector<uint8_t>& data, j2735_msgs::MapData& out_msg) {
+  j2735_map_t& map = scratch<j2735_map_t>();
+  if (j2735_decode_map(data.data(), data.size(), &map) != 0) {
+    return false;
+  }
+  out_msg.msg_issue_revision = map.msg_issue_revision;
+  out_msg.intersections.clear();
+  out_msg.intersections_exists = map.intersection_exists;
+  if (out_msg.intersections_exists) {
+    out_msg.intersections.emplace_back();
+    j2735_msgs::IntersectionGeometry& intersection = out_msg.intersections.back();
+    intersection.id.id = map.intersection_id;
+    intersection.revision = map.revision;
+    intersection.ref_point.latitude = map.latitude;
+    intersection.ref_point.longitude = map.longitude;
+    intersection.ref_point.elevation_exists = map.elevation_exists;
+    if (intersection.ref_point.elevation_exists) {
+      intersection.ref_point.elevation = map.elevation;
+    }
+    intersection.lane_width_exists = map.lane_width_exists;
+    if (intersection.lane_width_exists) {
+      intersection.lane_width = map.lane_width;
+    }
+    intersection.lane_set.lane_list.reserve(map.lane_count);
+    for (uint16_t i = 0; i < map.lane_count; i++) {
+      const j2735_lane_t& in_lane = map.lanes[i];
+      intersection.lane_set.lane_list.emplace_back();
+      j2735_msgs::GenericLane& lane = intersection.lane_set.lane_list.back();
+      lane.lane_id = in_lane.lane_id;
+      lane.ingress_approach_exists = in_lane.ingress_approach_exists;
+      if (lane.ingress_approach_exists) {
+        lane.ingress_approach = in_lane.ingress_approach;
+      }
+      lane.egress_approach_exists = in_lane.egress_approach_exists;
+      if (lane.egress_approach_exists) {
+        lane.egress_approach = in_lane.egress_approach;
+      }
+      lane.lane_attributes.directional_use.lane_direction = in_lane.lane_direction;
+      lane.lane_attributes.lane_type.choice = in_lane.lane_type;
+      // Only the choice of NODE_SET_XY is supported
+      lane.node_list.choice = j2735_msgs::NodeListXY::NODE_SET_XY;
+      std::vector<j2735_msgs::NodeXY>& nodes = lane.node_list.nodes.node_set_xy;
+      nodes.reserve(in_lane.node_count);
+      for (uint8_t j = 0; j < in_lane.node_count; j++) {
+        const j2735_node_t& in_node = in_lane.nodes[j];
+        nodes.emplace_back();
+        j2735_msgs::NodeOffsetPointXY& delta = nodes.back().delta;
+        switch (in_node.type) {
+          case J2735_NODE_XY1:
+            delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_XY1;
+            setNodeOffset(in_node, delta.node_xy1);
+            break;
+          case J2735_NODE_XY2:
+            delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_XY2;
+            setNodeOffset(in_node, delta.node_xy2);
+            break;
+          case J2735_NODE_XY3:
+            delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_XY3;
+            setNodeOffset(in_node, delta.node_xy3);
+            break;
+          case J2735_NODE_XY4:
+            delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_XY4;
+            setNodeOffset(in_node, delta.node_xy4);
+            break;
+          case J2735_NODE_XY5:
+            delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_XY5;
+            setNodeOffset(in_node, delta.node_xy5);
+            break;
+          case J2735_NODE_XY6:
+            delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_XY6;
+            setNodeOffset(in_node, delta.node_xy6);
+            break;
+          case J2735_NODE_LATLON:
+            delta.choice = j2735_msgs::NodeOffsetPointXY::NODE_LATLON;
+            delta.node_latlon.latitude = in_node.x;
+            delta.node_latlon.longitude = in_node.y;
+            break;
+          default:
+            break;
+        }
+      }
+      lane.connects_to.connect_to_list.reserve(in_lane.connection_count);
+      for (uint8_t j = 0; j < in_lane.connection_count; j++) {
+        const j2735_connection_t& in_connection = in_lane.connections[j];
+        lane.connects_to.connect_to_list.emplace_back();
+        j2735_msgs::Connection& connection = lane.connects_to.connect_to_list.back();
+        connection.connecting_lane.lane = in_connection.connecting_lane;
+        connection.signal_group_exists = in_connection.signal_group_exists;
+        if (connection.signal_group_exists) {
+          connection.signal_group = in_connection.signal_group;
+        }
+      }
+      lane.connects_to_exists = in_lane.connection_count > 0;
+    }
+  }
+  out_msg.header.frame_id = "0";
+  out_msg.header.stamp = ros::Time::now();
+  return true;
+}
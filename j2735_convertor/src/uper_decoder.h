@@ -0,0 +1,69 @@
+#pragma once
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <vector>
+#include <j2735_msgs/BSM.h>
+#include <j2735_msgs/SPAT.h>
+#include <j2735_msgs/MapData.h>
+
+/**
+ * @class UPERDecoder
+ * @brief Is the class responsible for decoding UPER encoded J2735 messages directly into j2735_msgs
+ * 
+ * Wraps the native codec in libasn1c so inbound BSM, SPAT and MAP messages can be decoded in this node
+ * without a round trip through the JNI decoders of the Java message node.
+ * The decoded messages hold the same fields as the ones published by the message node.
+ */
+class UPERDecoder 
+{
+  public:
+
+    /**
+     * @brief Decode a UPER encoded MessageFrame holding a BasicSafetyMessage
+     * 
+     * @param data The encoded message
+     * @param out_msg The message to store the output
+     * 
+     * @return True if the message could be decoded, false otherwise
+     */
+    static bool decode(const std::vector<uint8_t>& data, j2735_msgs::BSM& out_msg);
+
+    /**
+     * @brief Decode a UPER encoded MessageFrame holding a SPAT
+     * 
+     * @param data The encoded message
+     * @param out_msg The message to store the output
+     * 
+     * @return True if the message could be decoded, false otherwise
+     * 
+     * As in the message node only the first intersection is decoded
+     */
+    static bool decode(const std::vector<uint8_t>& data, j2735_msgs::SPAT& out_msg);
+
+    /**
+     * @brief Decode a UPER encoded MessageFrame holding a MapData
+     * 
+     * @param data The encoded message
+     * @param out_msg The message to store the output
+     * 
+     * @return True if the message could be decoded, false otherwise
+     * 
+     * As in the message node only the first intersection is decoded
+     */
+    static bool decode(const std::vector<uint8_t>& data, j2735_msgs::MapData& out_msg);
+};
@@ -55,18 +55,19 @@ class ValueConvertor
      * @param unavailability_value The value of the input which would mean that value was not representative of actual data
      * 
      * @return The converted input value in the new output unit and type
+     * 
+     * The conversion factors are constants so once inlined the reciprocal is computed at compile time and the
+     * conversion is a multiplication. Selects are used instead of branches as availability is data dependent.
      */
     template<typename T, typename U, typename V, typename W, typename X>
     static T valueJ2735ToCav(const U in, const double conversion_factor,
       V& presence_vector, const W presence_flag, const X unavailability_value) {
       
-      if (in != (U)unavailability_value) { // If the value is available
-        presence_vector |= (V)presence_flag; // Mark the field as available
-        return (T)(in / conversion_factor); // Do unit conversion
-      } else {
-        presence_vector &= ~presence_flag; // Mark the field as unavailable
-        return 0; // Return ROS default of 0 for all fields
-      }
+      const bool available = in != (U)unavailability_value;
+      // Mark the field as available or unavailable
+      presence_vector = available ? (V)(presence_vector | (V)presence_flag) : (V)(presence_vector & ~(V)presence_flag);
+      // Do unit conversion, returning the ROS default of 0 for unavailable fields
+      return available ? (T)(in * (1.0 / conversion_factor)) : (T)0;
     }
 
     /**
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "stub_j2735_codec.h"
+
+namespace stub_codec
+{
+  j2735_bsm_core_t bsm;
+  j2735_spat_t spat;
+  j2735_map_t map;
+  std::vector<uint8_t> last_payload;
+}
+
+namespace {
+  // DSRCmsgID values at the start of a UPER encoded MessageFrame
+  const uint16_t MAP_MSG_ID = 18;
+  const uint16_t SPAT_MSG_ID = 19;
+  const uint16_t BSM_MSG_ID = 20;
+
+  template<typename T>
+  int stubDecode(const uint8_t *data, size_t length, uint16_t msg_id, const T& decoded, T *out) {
+    stub_codec::last_payload.assign(data, data + length);
+    if (length < 2 || ((data[0] << 8) | data[1]) != msg_id) {
+      return -1;
+    }
+    *out = decoded;
+    return 0;
+  }
+}
+
+int j2735_decode_bsm(const uint8_t *data, size_t length, j2735_bsm_core_t *bsm) {
+  return stubDecode(data, length, BSM_MSG_ID, stub_codec::bsm, bsm);
+}
+
+int j2735_decode_spat(const uint8_t *data, size_t length, j2735_spat_t *spat) {
+  return stubDecode(data, length, SPAT_MSG_ID, stub_codec::spat, spat);
+}
+
+int j2735_decode_map(const uint8_t *data, size_t length, j2735_map_t *map) {
+  return stubDecode(data, length, MAP_MSG_ID, stub_codec::map, map);
+}
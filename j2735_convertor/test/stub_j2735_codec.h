@@ -0,0 +1,35 @@
+#pragma once
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <vector>
+#include <j2735_codec.h>
+
+/**
+ * Stub of the native decoders in libasn1c used to test UPERDecoder without the asn1c workspace.
+ * A payload is accepted when its MessageFrame starts with the message id of the requested type,
+ * the decoder then returns the structure set by the test and records the payload it was given.
+ */
+namespace stub_codec
+{
+  extern j2735_bsm_core_t bsm;
+  extern j2735_spat_t spat;
+  extern j2735_map_t map;
+
+  // The last payload passed to any of the decoders
+  extern std::vector<uint8_t> last_payload;
+}
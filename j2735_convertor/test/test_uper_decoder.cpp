@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <ros/time.h>
+#include "uper_decoder.h"
+#include "stub_j2735_codec.h"
+
+/**
+ * Read a payload of the lib_asn1c corpus
+ */
+std::vector<uint8_t> loadCorpusPayload(const std::string& file_name) {
+  std::ifstream file(std::string(ASN1C_CORPUS_DIR) + "/" + file_name, std::ios::binary);
+  return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+TEST(UPERDecoder, decodeBSM)
+{
+  std::vector<uint8_t> payload = loadCorpusPayload("bsm_1.uper");
+  ASSERT_FALSE(payload.empty());
+
+  j2735_bsm_core_t& bsm = stub_codec::bsm;
+  bsm = j2735_bsm_core_t();
+  bsm.msg_count = 12;
+  bsm.id[0] = 1; bsm.id[1] = 2; bsm.id[2] = 3; bsm.id[3] = 4;
+  bsm.sec_mark = 41000;
+  bsm.latitude = 389549844;
+  bsm.longitude = -771493239;
+  bsm.elevation = 390;
+  bsm.semi_major = 20;
+  bsm.semi_minor = 21;
+  bsm.orientation = 6000;
+  bsm.transmission = 2;
+  bsm.speed = 1100;
+  bsm.heading = 7200;
+  bsm.angle = -5;
+  bsm.accel_longitudinal = -120;
+  bsm.accel_lateral = 30;
+  bsm.accel_vert = -2;
+  bsm.accel_yaw_rate = 150;
+  bsm.wheel_brakes = 0x10;
+  bsm.traction = 1;
+  bsm.abs = 2;
+  bsm.scs = 3;
+  bsm.brake_boost = 1;
+  bsm.aux_brakes = 2;
+  bsm.vehicle_width = 185;
+  bsm.vehicle_length = 480;
+
+  j2735_msgs::BSM msg;
+  ASSERT_TRUE(UPERDecoder::decode(payload, msg));
+  EXPECT_EQ(payload, stub_codec::last_payload);
+
+  const j2735_msgs::BSMCoreData& core = msg.core_data;
+  EXPECT_EQ(12, core.msg_count);
+  ASSERT_EQ(4u, core.id.size());
+  EXPECT_EQ(1, core.id[0]);
+  EXPECT_EQ(4, core.id[3]);
+  EXPECT_EQ(41000, core.sec_mark);
+  EXPECT_EQ(389549844, core.latitude);
+  EXPECT_EQ(-771493239, core.longitude);
+  EXPECT_EQ(390, core.elev);
+  EXPECT_EQ(20, core.accuracy.semiMajor);
+  EXPECT_EQ(21, core.accuracy.semiMinor);
+  EXPECT_EQ(6000, core.accuracy.orientation);
+  EXPECT_EQ(2, core.transmission.transmission_state);
+  EXPECT_EQ(1100, core.speed);
+  EXPECT_EQ(7200, core.heading);
+  EXPECT_EQ(-5, core.angle);
+  EXPECT_EQ(-120, core.accelSet.longitudinal);
+  EXPECT_EQ(30, core.accelSet.lateral);
+  EXPECT_EQ(-2, core.accelSet.vert);
+  EXPECT_EQ(150, core.accelSet.yaw_rate);
+  EXPECT_EQ(0x10, core.brakes.wheelBrakes.brake_applied_status);
+  EXPECT_EQ(1, core.brakes.traction.traction_control_status);
+  EXPECT_EQ(2, core.brakes.abs.anti_lock_brake_status);
+  EXPECT_EQ(3, core.brakes.scs.stability_control_status);
+  EXPECT_EQ(1, core.brakes.brakeBoost.brake_boost_applied);
+  EXPECT_EQ(2, core.brakes.auxBrakes.auxiliary_brake_status);
+  EXPECT_EQ(185, core.size.vehicle_width);
+  EXPECT_EQ(480, core.size.vehicle_length);
+  EXPECT_EQ("MessageConsumer", msg.header.frame_id);
+}
+
+TEST(UPERDecoder, decodeSPAT)
+{
+  std::vector<uint8_t> payload = loadCorpusPayload("spat_1.uper");
+  ASSERT_FALSE(payload.empty());
+
+  j2735_spat_t& spat = stub_codec::spat;
+  spat = j2735_spat_t();
+  spat.time_stamp_exists = 1;
+  spat.time_stamp = 120000;
+  spat.intersection_id = 9709;
+  spat.revision = 3;
+  spat.moy_exists = 0;
+  spat.intersection_time_stamp_exists = 1;
+  spat.intersection_time_stamp = 35000;
+  spat.state_count = 2;
+  spat.states[0].signal_group = 1;
+  spat.states[0].event_count = 1;
+  spat.states[0].events[0].event_state = 3;
+  spat.states[0].events[0].timing_exists = 1;
+  spat.states[0].events[0].min_end_time = 22000;
+  spat.states[0].events[0].max_end_time_exists = 1;
+  spat.states[0].events[0].max_end_time = 22500;
+  spat.states[1].signal_group = 2;
+  spat.states[1].event_count = 2;
+  spat.states[1].events[0].event_state = 6;
+  spat.states[1].events[1].event_state = 8;
+  spat.states[1].events[1].timing_exists = 1;
+  spat.states[1].events[1].start_time_exists = 1;
+  spat.states[1].events[1].start_time = 21000;
+  spat.states[1].events[1].min_end_time = 23000;
+  spat.states[1].events[1].next_time_exists = 1;
+  spat.states[1].events[1].next_time = 24000;
+
+  j2735_msgs::SPAT msg;
+  // Decoding into a reused message must not keep the intersections of the previous one
+  msg.intersections.intersection_state_list.resize(3);
+  ASSERT_TRUE(UPERDecoder::decode(payload, msg));
+  EXPECT_EQ(payload, stub_codec::last_payload);
+
+  EXPECT_TRUE(msg.time_stamp_exists);
+  EXPECT_EQ(120000u, msg.time_stamp);
+  ASSERT_EQ(1u, msg.intersections.intersection_state_list.size());
+  const j2735_msgs::IntersectionState& intersection = msg.intersections.intersection_state_list[0];
+  EXPECT_EQ(9709, intersection.id.id);
+  EXPECT_EQ(3, intersection.revision);
+  EXPECT_FALSE(intersection.moy_exists);
+  EXPECT_TRUE(intersection.time_stamp_exists);
+  EXPECT_EQ(35000, intersection.time_stamp);
+  ASSERT_EQ(2u, intersection.states.movement_list.size());
+
+  const j2735_msgs::MovementState& state_1 = intersection.states.movement_list[0];
+  EXPECT_EQ(1, state_1.signal_group);
+  ASSERT_EQ(1u, state_1.state_time_speed.movement_event_list.size());
+  const j2735_msgs::MovementEvent& event_1 = state_1.state_time_speed.movement_event_list[0];
+  EXPECT_EQ(3, event_1.event_state.movement_phase_state);
+  EXPECT_TRUE(event_1.timing_exists);
+  EXPECT_FALSE(event_1.timing.start_time_exists);
+  EXPECT_EQ(22000, event_1.timing.min_end_time);
+  EXPECT_TRUE(event_1.timing.max_end_time_exists);
+  EXPECT_EQ(22500, event_1.timing.max_end_time);
+  EXPECT_FALSE(event_1.timing.next_time_exists);
+
+  const j2735_msgs::MovementState& state_2 = intersection.states.movement_list[1];
+  EXPECT_EQ(2, state_2.signal_group);
+  ASSERT_EQ(2u, state_2.state_time_speed.movement_event_list.size());
+  EXPECT_EQ(6, state_2.state_time_speed.movement_event_list[0].event_state.movement_phase_state);
+  EXPECT_FALSE(state_2.state_time_speed.movement_event_list[0].timing_exists);
+  const j2735_msgs::MovementEvent& event_2 = state_2.state_time_speed.movement_event_list[1];
+  EXPECT_EQ(8, event_2.event_state.movement_phase_state);
+  EXPECT_TRUE(event_2.timing.start_time_exists);
+  EXPECT_EQ(21000, event_2.timing.start_time);
+  EXPECT_EQ(23000, event_2.timing.min_end_time);
+  EXPECT_FALSE(event_2.timing.max_end_time_exists);
+  EXPECT_TRUE(event_2.timing.next_time_exists);
+  EXPECT_EQ(24000, event_2.timing.next_time);
+}
+
+TEST(UPERDecoder, decodeMap)
+{
+  std::vector<uint8_t> payload = loadCorpusPayload("map_1.uper");
+  ASSERT_FALSE(payload.empty());
+
+  // Intersection and first lane as expected for this payload by the Java MapDecodeTest
+  j2735_map_t& map = stub_codec::map;
+  map = j2735_map_t();
+  map.msg_issue_revision = 2;
+  map.intersection_exists = 1;
+  map.intersection_id = 9709;
+  map.revision = 3;
+  map.latitude = 389549844;
+  map.longitude = -771493239;
+  map.elevation_exists = 1;
+  map.elevation = 390;
+  map.lane_width_exists = 1;
+  map.lane_width = 274;
+  map.lane_count = 2;
+  j2735_lane_t& lane_1 = map.lanes[0];
+  lane_1.lane_id = 1;
+  lane_1.ingress_approach_exists = 1;
+  lane_1.ingress_approach = 1;
+  lane_1.lane_direction = 2;
+  lane_1.lane_type = 0;
+  lane_1.node_count = 7;
+  for (uint8_t i = 0; i < lane_1.node_count; i++) {
+    lane_1.nodes[i].type = J2735_NODE_XY1 + i;
+    lane_1.nodes[i].x = 100 * (i + 1);
+    lane_1.nodes[i].y = -100 * (i + 1);
+  }
+  lane_1.connection_count = 1;
+  lane_1.connections[0].connecting_lane = 5;
+  lane_1.connections[0].signal_group_exists = 1;
+  lane_1.connections[0].signal_group = 2;
+  j2735_lane_t& lane_2 = map.lanes[1];
+  lane_2.lane_id = 5;
+  lane_2.egress_approach_exists = 1;
+  lane_2.egress_approach = 5;
+  lane_2.lane_direction = 1;
+  lane_2.lane_type = 0;
+
+  j2735_msgs::MapData msg;
+  ASSERT_TRUE(UPERDecoder::decode(payload, msg));
+  EXPECT_EQ(payload, stub_codec::last_payload);
+
+  EXPECT_EQ(2, msg.msg_issue_revision);
+  ASSERT_TRUE(msg.intersections_exists);
+  ASSERT_EQ(1u, msg.intersections.size());
+  const j2735_msgs::IntersectionGeometry& intersection = msg.intersections[0];
+  EXPECT_EQ(9709, intersection.id.id);
+  EXPECT_EQ(3, intersection.revision);
+  EXPECT_EQ(389549844, intersection.ref_point.latitude);
+  EXPECT_EQ(-771493239, intersection.ref_point.longitude);
+  EXPECT_TRUE(intersection.ref_point.elevation_exists);
+  EXPECT_EQ(390, intersection.ref_point.elevation);
+  EXPECT_TRUE(intersection.lane_width_exists);
+  EXPECT_EQ(274, intersection.lane_width);
+  ASSERT_EQ(2u, intersection.lane_set.lane_list.size());
+
+  const j2735_msgs::GenericLane& ingress = intersection.lane_set.lane_list[0];
+  EXPECT_EQ(1, ingress.lane_id);
+  EXPECT_TRUE(ingress.ingress_approach_exists);
+  EXPECT_EQ(1, ingress.ingress_approach);
+  EXPECT_FALSE(ingress.egress_approach_exists);
+  EXPECT_EQ(2, ingress.lane_attributes.directional_use.lane_direction);
+  EXPECT_EQ(0, ingress.lane_attributes.lane_type.choice);
+  EXPECT_EQ(j2735_msgs::NodeListXY::NODE_SET_XY, ingress.node_list.choice);
+  const std::vector<j2735_msgs::NodeXY>& nodes = ingress.node_list.nodes.node_set_xy;
+  ASSERT_EQ(7u, nodes.size());
+  EXPECT_EQ(j2735_msgs::NodeOffsetPointXY::NODE_XY1, nodes[0].delta.choice);
+  EXPECT_EQ(100, nodes[0].delta.node_xy1.x);
+  EXPECT_EQ(-100, nodes[0].delta.node_xy1.y);
+  EXPECT_EQ(j2735_msgs::NodeOffsetPointXY::NODE_XY2, nodes[1].delta.choice);
+  EXPECT_EQ(200, nodes[1].delta.node_xy2.x);
+  EXPECT_EQ(-200, nodes[1].delta.node_xy2.y);
+  EXPECT_EQ(j2735_msgs::NodeOffsetPointXY::NODE_XY3, nodes[2].delta.choice);
+  EXPECT_EQ(300, nodes[2].delta.node_xy3.x);
+  EXPECT_EQ(-300, nodes[2].delta.node_xy3.y);
+  EXPECT_EQ(j2735_msgs::NodeOffsetPointXY::NODE_XY4, nodes[3].delta.choice);
+  EXPECT_EQ(400, nodes[3].delta.node_xy4.x);
+  EXPECT_EQ(-400, nodes[3].delta.node_xy4.y);
+  EXPECT_EQ(j2735_msgs::NodeOffsetPointXY::NODE_XY5, nodes[4].delta.choice);
+  EXPECT_EQ(500, nodes[4].delta.node_xy5.x);
+  EXPECT_EQ(-500, nodes[4].delta.node_xy5.y);
+  EXPECT_EQ(j2735_msgs::NodeOffsetPointXY::NODE_XY6, nodes[5].delta.choice);
+  EXPECT_EQ(600, nodes[5].delta.node_xy6.x);
+  EXPECT_EQ(-600, nodes[5].delta.node_xy6.y);
+  EXPECT_EQ(j2735_msgs::NodeOffsetPointXY::NODE_LATLON, nodes[6].delta.choice);
+  EXPECT_EQ(700, nodes[6].delta.node_latlon.latitude);
+  EXPECT_EQ(-700, nodes[6].delta.node_latlon.longitude);
+  EXPECT_TRUE(ingress.connects_to_exists);
+  ASSERT_EQ(1u, ingress.connects_to.connect_to_list.size());
+  EXPECT_EQ(5, ingress.connects_to.connect_to_list[0].connecting_lane.lane);
+  EXPECT_TRUE(ingress.connects_to.connect_to_list[0].signal_group_exists);
+  EXPECT_EQ(2, ingress.connects_to.connect_to_list[0].signal_group);
+
+  const j2735_msgs::GenericLane& egress = intersection.lane_set.lane_list[1];
+  EXPECT_EQ(5, egress.lane_id);
+  EXPECT_FALSE(egress.ingress_approach_exists);
+  EXPECT_TRUE(egress.egress_approach_exists);
+  EXPECT_EQ(5, egress.egress_approach);
+  EXPECT_EQ(1, egress.lane_attributes.directional_use.lane_direction);
+  EXPECT_TRUE(egress.node_list.nodes.node_set_xy.empty());
+  EXPECT_FALSE(egress.connects_to_exists);
+}
+
+TEST(UPERDecoder, rejectOtherMessageTypes)
+{
+  std::vector<uint8_t> bsm_payload = loadCorpusPayload("bsm_1.uper");
+  std::vector<uint8_t> spat_payload = loadCorpusPayload("spat_1.uper");
+  ASSERT_FALSE(bsm_payload.empty());
+  ASSERT_FALSE(spat_payload.empty());
+
+  j2735_msgs::BSM bsm;
+  j2735_msgs::SPAT spat;
+  j2735_msgs::MapData map;
+  EXPECT_FALSE(UPERDecoder::decode(spat_payload, bsm));
+  EXPECT_FALSE(UPERDecoder::decode(bsm_payload, spat));
+  EXPECT_FALSE(UPERDecoder::decode(bsm_payload, map));
+  EXPECT_FALSE(UPERDecoder::decode(std::vector<uint8_t>(), bsm));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  // The decoders stamp their output without a running node
+  ros::Time::init();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/*
+ * Offline benchmark for the J2735 codec:
+ * Decodes and re-encodes every payload of a corpus directory and reports messages and bytes per second
+ * for each message type handled by wrapper.c. The type of a payload is taken from its file name, e.g. bsm_1.uper.
+ * Decoding is measured as uper_decode and ASN_STRUCT_FREE of a MessageFrame, which is the work the JNI decoders do
+ * before copying results to Java. Encoding re-encodes the decoded frames with uper_encode_to_buffer.
+ * The native codec functions of j2735_codec.h, which back j2735_convertor and the buffer based JNI methods,
+ * are reported as separate rows.
+ * Every re-encoded payload is compared with its corpus file so codec changes which alter the encoding are noticed.
+ *
+ * Usage: asn1c_codec_benchmark CORPUS_DIR [--iterations N]
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MessageFrame.h"
+#include "j2735_codec.h"
+
+#define MAX_PAYLOADS 256
+#define ENCODE_BUFFER_SIZE 4096
+
+static const char *MESSAGE_TYPES[] = {
+	"bsm", "mobility_request", "mobility_response", "mobility_path", "mobility_operation", "map", "spat"
+};
+#define NUM_MESSAGE_TYPES (sizeof(MESSAGE_TYPES) / sizeof(MESSAGE_TYPES[0]))
+
+typedef struct payload {
+	int type;
+	uint8_t *data;
+	size_t size;
+	MessageFrame_t *frame;
+} payload_t;
+
+typedef struct result {
+	size_t messages;
+	size_t bytes;
+	double seconds;
+} result_t;
+
+static double now_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(void) {
+	fprintf(stderr, "Usage: asn1c_codec_benchmark CORPUS_DIR [--iterations N]\n");
+}
+
+/**
+ * Find the message type of a corpus file named <type>_<n>.uper. Returns -1 for unknown files.
+ */
+static int message_type(const char *file_name) {
+	for(size_t i = 0; i < NUM_MESSAGE_TYPES; i++) {
+		size_t length = strlen(MESSAGE_TYPES[i]);
+		if(strncmp(file_name, MESSAGE_TYPES[i], length) == 0 && file_name[length] == '_') {
+			return (int) i;
+		}
+	}
+	return -1;
+}
+
+static int load_corpus(const char *directory, payload_t *payloads, int max_payloads) {
+	DIR *dir = opendir(directory);
+	if(!dir) {
+		return -1;
+	}
+	int count = 0;
+	struct dirent *entry;
+	while((entry = readdir(dir)) != NULL && count < max_payloads) {
+		int type = message_type(entry -> d_name);
+		if(type < 0) {
+			continue;
+		}
+		char path[4096];
+		snprintf(path, sizeof(path), "%s/%s", directory, entry -> d_name);
+		FILE *file = fopen(path, "rb");
+		if(!file) {
+			continue;
+		}
+		fseek(file, 0, SEEK_END);
+		long size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		uint8_t *data = malloc(size > 0 ? size : 1);
+		if(data && size > 0 && fread(data, 1, size, file) == (size_t) size) {
+			payloads[count].type = type;
+			payloads[count].data = data;
+			payloads[count].size = size;
+			payloads[count].frame = NULL;
+			count++;
+		} else {
+			free(data);
+		}
+		fclose(file);
+	}
+	closedir(dir);
+	return count;
+}
+
+static void print_row(const char *name, int payload_count, const result_t *decode, const result_t *encode, const char *roundtrip) {
+	printf("%-34s %8d %10.0f", name, payload_count, decode -> messages ? (double) decode -> bytes / decode -> messages : 0.0);
+	if(decode -> seconds > 0) {
+		printf(" %12.0f %10.2f", decode -> messages / decode -> seconds, decode -> bytes / decode -> seconds / 1e6);
+	} else {
+		printf(" %12s %10s", "-", "-");
+	}
+	if(encode -> seconds > 0) {
+		printf(" %12.0f %10.2f", encode -> messages / encode -> seconds, encode -> bytes / encode -> seconds / 1e6);
+	} else {
+		printf(" %12s %10s", "-", "-");
+	}
+	printf(" %s\n", roundtrip);
+}
+
+/**
+ * Benchmark uper_decode and uper_encode_to_buffer of all payloads of one message type
+ */
+static void benchmark_frames(int type, payload_t *payloads, int count, int iterations) {
+	result_t decode = {0, 0, 0};
+	result_t encode = {0, 0, 0};
+	int payload_count = 0;
+	int decoded = 0;
+	int matching = 0;
+	uint8_t buffer[ENCODE_BUFFER_SIZE];
+
+	double start = now_seconds();
+	for(int n = 0; n < iterations; n++) {
+		for(int i = 0; i < count; i++) {
+			if(payloads[i].type != type) {
+				continue;
+			}
+			MessageFrame_t *message = 0;
+			asn_dec_rval_t rval = uper_decode(0, &asn_DEF_MessageFrame, (void **) &message, payloads[i].data, payloads[i].size, 0, 0);
+			if(rval.code == RC_OK) {
+				decode.messages++;
+				decode.bytes += payloads[i].size;
+			}
+			ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+		}
+	}
+	decode.seconds = now_seconds() - start;
+
+	// Keep one decoded frame per payload to encode
+	for(int i = 0; i < count; i++) {
+		if(payloads[i].type != type) {
+			continue;
+		}
+		payload_count++;
+		asn_dec_rval_t rval = uper_decode(0, &asn_DEF_MessageFrame, (void **) &payloads[i].frame, payloads[i].data, payloads[i].size, 0, 0);
+		if(rval.code != RC_OK) {
+			ASN_STRUCT_FREE(asn_DEF_MessageFrame, payloads[i].frame);
+			payloads[i].frame = NULL;
+			continue;
+		}
+		decoded++;
+		asn_enc_rval_t ec = uper_encode_to_buffer(&asn_DEF_MessageFrame, 0, payloads[i].frame, buffer, sizeof(buffer));
+		size_t length = ec.encoded < 0 ? 0 : (ec.encoded + 7) / 8;
+		if(ec.encoded >= 0 && length == payloads[i].size && memcmp(buffer, payloads[i].data, length) == 0) {
+			matching++;
+		}
+	}
+
+	start = now_seconds();
+	for(int n = 0; n < iterations; n++) {
+		for(int i = 0; i < count; i++) {
+			if(payloads[i].type != type || !payloads[i].frame) {
+				continue;
+			}
+			asn_enc_rval_t ec = uper_encode_to_buffer(&asn_DEF_MessageFrame, 0, payloads[i].frame, buffer, sizeof(buffer));
+			if(ec.encoded >= 0) {
+				encode.messages++;
+				encode.bytes += (ec.encoded + 7) / 8;
+			}
+		}
+	}
+	encode.seconds = now_seconds() - start;
+
+	for(int i = 0; i < count; i++) {
+		if(payloads[i].type == type && payloads[i].frame) {
+			ASN_STRUCT_FREE(asn_DEF_MessageFrame, payloads[i].frame);
+			payloads[i].frame = NULL;
+		}
+	}
+	if(payload_count == 0) {
+		return;
+	}
+	char roundtrip[64];
+	snprintf(roundtrip, sizeof(roundtrip), "%d/%d decoded, %d/%d identical", decoded, payload_count, matching, payload_count);
+	print_row(MESSAGE_TYPES[type], payload_count, &decode, &encode, roundtrip);
+}
+
+/*
+ * Adapters giving the native codec functions of the round trip message types one signature
+ */
+typedef int (*native_decoder_t)(const uint8_t *data, size_t length, void *message);
+typedef ssize_t (*native_encoder_t)(const void *message, uint8_t *buffer, size_t buffer_size);
+
+static int decode_bsm(const uint8_t *data, size_t length, void *message) {
+	return j2735_decode_bsm(data, length, message);
+}
+static ssize_t encode_bsm(const void *message, uint8_t *buffer, size_t buffer_size) {
+	return j2735_encode_bsm(message, buffer, buffer_size);
+}
+static int decode_request(const uint8_t *data, size_t length, void *message) {
+	return j2735_decode_mobility_request(data, length, message);
+}
+static ssize_t encode_request(const void *message, uint8_t *buffer, size_t buffer_size) {
+	return j2735_encode_mobility_request(message, buffer, buffer_size);
+}
+static int decode_response(const uint8_t *data, size_t length, void *message) {
+	return j2735_decode_mobility_response(data, length, message);
+}
+static ssize_t encode_response(const void *message, uint8_t *buffer, size_t buffer_size) {
+	return j2735_encode_mobility_response(message, buffer, buffer_size);
+}
+static int decode_path(const uint8_t *data, size_t length, void *message) {
+	return j2735_decode_mobility_path(data, length, message);
+}
+static ssize_t encode_path(const void *message, uint8_t *buffer, size_t buffer_size) {
+	return j2735_encode_mobility_path(message, buffer, buffer_size);
+}
+static int decode_operation(const uint8_t *data, size_t length, void *message) {
+	return j2735_decode_mobility_operation(data, length, message);
+}
+static ssize_t encode_operation(const void *message, uint8_t *buffer, size_t buffer_size) {
+	return j2735_encode_mobility_operation(message, buffer, buffer_size);
+}
+
+/**
+ * Benchmark a native decoder and encoder of j2735_codec.h on all payloads of one message type
+ */
+static void benchmark_native(int type, native_decoder_t decode_message, native_encoder_t encode_message,
+		payload_t *payloads, int count, int iterations) {
+	static union {
+		j2735_bsm_core_t bsm;
+		j2735_mobility_request_t request;
+		j2735_mobility_response_t response;
+		j2735_mobility_path_t path;
+		j2735_mobility_operation_t operation;
+	} message;
+	result_t decode = {0, 0, 0};
+	result_t encode = {0, 0, 0};
+	int payload_count = 0;
+	int matching = 0;
+	uint8_t buffer[ENCODE_BUFFER_SIZE];
+
+	double start = now_seconds();
+	for(int n = 0; n < iterations; n++) {
+		for(int i = 0; i < count; i++) {
+			if(payloads[i].type == type && decode_message(payloads[i].data, payloads[i].size, &message) == 0) {
+				decode.messages++;
+				decode.bytes += payloads[i].size;
+			}
+		}
+	}
+	decode.seconds = now_seconds() - start;
+
+	for(int i = 0; i < count; i++) {
+		if(payloads[i].type != type) {
+			continue;
+		}
+		payload_count++;
+		if(decode_message(payloads[i].data, payloads[i].size, &message) != 0) {
+			continue;
+		}
+		start = now_seconds();
+		for(int n = 0; n < iterations; n++) {
+			ssize_t length = encode_message(&message, buffer, sizeof(buffer));
+			if(length >= 0) {
+				encode.messages++;
+				encode.bytes += length;
+			}
+		}
+		encode.seconds += now_seconds() - start;
+		ssize_t length = encode_message(&message, buffer, sizeof(buffer));
+		if(length == (ssize_t) payloads[i].size && memcmp(buffer, payloads[i].data, length) == 0) {
+			matching++;
+		}
+	}
+	if(payload_count == 0) {
+		return;
+	}
+	char name[64];
+	char roundtrip[64];
+	snprintf(name, sizeof(name), "%s (j2735_codec)", MESSAGE_TYPES[type]);
+	snprintf(roundtrip, sizeof(roundtrip), "%d/%d identical", matching, payload_count);
+	print_row(name, payload_count, &decode, &encode, roundtrip);
+}
+
+/**
+ * Benchmark the native SPAT and MAP decoders of j2735_codec.h
+ */
+static void benchmark_native_decoder(int type, payload_t *payloads, int count, int iterations) {
+	static j2735_spat_t spat;
+	static j2735_map_t map;
+	result_t decode = {0, 0, 0};
+	result_t encode = {0, 0, 0};
+	int payload_count = 0;
+
+	double start = now_seconds();
+	for(int n = 0; n < iterations; n++) {
+		for(int i = 0; i < count; i++) {
+			if(payloads[i].type != type) {
+				continue;
+			}
+			int res = strcmp(MESSAGE_TYPES[type], "map") == 0 ?
+				j2735_decode_map(payloads[i].data, payloads[i].size, &map) :
+				j2735_decode_spat(payloads[i].data, payloads[i].size, &spat);
+			if(res == 0) {
+				decode.messages++;
+				decode.bytes += payloads[i].size;
+			}
+		}
+	}
+	decode.seconds = now_seconds() - start;
+
+	for(int i = 0; i < count; i++) {
+		payload_count += payloads[i].type == type;
+	}
+	if(payload_count == 0) {
+		return;
+	}
+	char name[64];
+	snprintf(name, sizeof(name), "%s (j2735_codec)", MESSAGE_TYPES[type]);
+	print_row(name, payload_count, &decode, &encode, "decode only");
+}
+
+int main(int argc, char **argv) {
+	int iterations = 10000;
+	const char *directory = NULL;
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+			iterations = atoi(argv[++i]);
+		} else if(argv[i][0] != '-' && !directory) {
+			directory = argv[i];
+		} else {
+			print_usage();
+			return 1;
+		}
+	}
+	if(!directory || iterations <= 0) {
+		print_usage();
+		return 1;
+	}
+
+	static payload_t payloads[MAX_PAYLOADS];
+	int count = load_corpus(directory, payloads, MAX_PAYLOADS);
+	if(count <= 0) {
+		fprintf(stderr, "No corpus files found in %s\n", directory);
+		return 1;
+	}
+
+	printf("%d payloads, %d iterations\n", count, iterations);
+	printf("%-34s %8s %10s %12s %10s %12s %10s %s\n", "message", "payloads", "bytes/msg",
+		"decode msg/s", "decode MB/s", "encode msg/s", "encode MB/s", "roundtrip");
+	for(size_t type = 0; type < NUM_MESSAGE_TYPES; type++) {
+		benchmark_frames(type, payloads, count, iterations);
+	}
+	benchmark_native(message_type("bsm_"), decode_bsm, encode_bsm, payloads, count, iterations);
+	benchmark_native(message_type("mobility_request_"), decode_request, encode_request, payloads, count, iterations);
+	benchmark_native(message_type("mobility_response_"), decode_response, encode_response, payloads, count, iterations);
+	benchmark_native(message_type("mobility_path_"), decode_path, encode_path, payloads, count, iterations);
+	benchmark_native(message_type("mobility_operation_"), decode_operation, encode_operation, payloads, count, iterations);
+	benchmark_native_decoder(message_type("map_"), payloads, count, iterations);
+	benchmark_native_decoder(message_type("spat_"), payloads, count, iterations);
+
+	for(int i = 0; i < count; i++) {
+		free(payloads[i].data);
+	}
+	return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/*
+ * libFuzzer harness for the J2735 codec:
+ * Feeds arbitrary bytes to the UPER MessageFrame decoder used by wrapper.c and to the native decoders of j2735_codec.h,
+ * including the mobility decoders behind the buffer based JNI methods, then re-encodes whatever decoded successfully.
+ * Seed it with the payloads in lib_asn1c/corpus.
+ *
+ * Usage: asn1c_codec_fuzzer [libFuzzer options] CORPUS_DIR
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MessageFrame.h"
+#include "j2735_codec.h"
+
+#define ENCODE_BUFFER_SIZE 4096
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	static j2735_spat_t spat;
+	static j2735_map_t map;
+	static j2735_mobility_request_t request;
+	static j2735_mobility_path_t path;
+	j2735_bsm_core_t bsm;
+	j2735_mobility_response_t response;
+	j2735_mobility_operation_t operation;
+	uint8_t buffer[ENCODE_BUFFER_SIZE];
+
+	MessageFrame_t *message = 0;
+	asn_dec_rval_t rval = uper_decode(0, &asn_DEF_MessageFrame, (void **) &message, data, size, 0, 0);
+	if(rval.code == RC_OK) {
+		uper_encode_to_buffer(&asn_DEF_MessageFrame, 0, message, buffer, sizeof(buffer));
+	}
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+
+	if(j2735_decode_bsm(data, size, &bsm) == 0) {
+		j2735_encode_bsm(&bsm, buffer, sizeof(buffer));
+	}
+	if(j2735_decode_mobility_request(data, size, &request) == 0) {
+		j2735_encode_mobility_request(&request, buffer, sizeof(buffer));
+	}
+	if(j2735_decode_mobility_response(data, size, &response) == 0) {
+		j2735_encode_mobility_response(&response, buffer, sizeof(buffer));
+	}
+	if(j2735_decode_mobility_path(data, size, &path) == 0) {
+		j2735_encode_mobility_path(&path, buffer, sizeof(buffer));
+	}
+	if(j2735_decode_mobility_operation(data, size, &operation) == 0) {
+		j2735_encode_mobility_operation(&operation, buffer, sizeof(buffer));
+	}
+	j2735_decode_spat(data, size, &spat);
+	j2735_decode_map(data, size, &map);
+	return 0;
+}
@@ -27,6 +27,22 @@ JNIEXPORT jbyteArray JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_Mobi
 JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage_decodeMobilityOperation
   (JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray);
 
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage
+ * Method:    encodeMobilityOperationBuffer
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage_encodeMobilityOperationBuffer
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage
+ * Method:    decodeMobilityOperationBuffer
+ * Signature: (Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage_decodeMobilityOperationBuffer
+  (JNIEnv *, jobject, jobject, jint);
+
 #ifdef __cplusplus
 }
 #endif
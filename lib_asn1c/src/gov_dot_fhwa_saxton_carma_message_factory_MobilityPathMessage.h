@@ -23,6 +23,22 @@ JNIEXPORT jbyteArray JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_Mobi
 JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage_decodeMobilityPath
   (JNIEnv *, jobject, jbyteArray, jobject, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jobject, jbyteArray, jobjectArray);
 
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage
+ * Method:    encodeMobilityPathBuffer
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage_encodeMobilityPathBuffer
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage
+ * Method:    decodeMobilityPathBuffer
+ * Signature: (Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage_decodeMobilityPathBuffer
+  (JNIEnv *, jobject, jobject, jint);
+
 #ifdef __cplusplus
 }
 #endif
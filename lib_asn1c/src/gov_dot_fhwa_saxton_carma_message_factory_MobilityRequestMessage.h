@@ -23,6 +23,22 @@ JNIEXPORT jbyteArray JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_Mobi
 JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage_decodeMobilityRequest
   (JNIEnv *, jobject, jbyteArray, jobject, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jobject, jobject, jbyteArray, jbyteArray, jobject, jbyteArray, jobjectArray, jbyteArray);
 
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage
+ * Method:    encodeMobilityRequestBuffer
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage_encodeMobilityRequestBuffer
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage
+ * Method:    decodeMobilityRequestBuffer
+ * Signature: (Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage_decodeMobilityRequestBuffer
+  (JNIEnv *, jobject, jobject, jint);
+
 #ifdef __cplusplus
 }
 #endif
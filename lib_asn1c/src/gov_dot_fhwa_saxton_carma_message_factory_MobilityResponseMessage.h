@@ -23,6 +23,22 @@ JNIEXPORT jbyteArray JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_Mobi
 JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage_decodeMobilityResponse
   (JNIEnv *, jobject, jbyteArray, jobject, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray);
 
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage
+ * Method:    encodeMobilityResponseBuffer
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage_encodeMobilityResponseBuffer
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage
+ * Method:    decodeMobilityResponseBuffer
+ * Signature: (Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage_decodeMobilityResponseBuffer
+  (JNIEnv *, jobject, jobject, jint);
+
 #ifdef __cplusplus
 }
 #endif
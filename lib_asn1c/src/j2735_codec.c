@@ -0,0 +1,589 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string.h>
+#include "j2735_codec.h"
+#include "MessageFrame.h"
+
+/**
+ * Decode a MessageFrame and check that it holds the expected message type.
+ * Returns NULL on failure, otherwise the frame must be released with ASN_STRUCT_FREE.
+ */
+static MessageFrame_t *decode_frame(const uint8_t *data, size_t length, MessageFrame__value_PR expected) {
+	MessageFrame_t *message = 0;
+	asn_dec_rval_t rval = uper_decode(0, &asn_DEF_MessageFrame, (void **) &message, data, length, 0, 0);
+	if(rval.code != RC_OK || message -> value.present != expected) {
+		ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+		return NULL;
+	}
+	return message;
+}
+
+int j2735_decode_bsm(const uint8_t *data, size_t length, j2735_bsm_core_t *bsm) {
+	MessageFrame_t *message = decode_frame(data, length, MessageFrame__value_PR_BasicSafetyMessage);
+	if(!message) {
+		return -1;
+	}
+	BSMcoreData_t *core = &message -> value.choice.BasicSafetyMessage.coreData;
+	if(core -> id.size != 4 || core -> brakes.wheelBrakes.size < 1) {
+		ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+		return -1;
+	}
+
+	bsm -> msg_count = core -> msgCnt;
+	memcpy(bsm -> id, core -> id.buf, 4);
+	bsm -> sec_mark = core -> secMark;
+	bsm -> latitude = core -> lat;
+	bsm -> longitude = core -> Long;
+	bsm -> elevation = core -> elev;
+	bsm -> semi_major = core -> accuracy.semiMajor;
+	bsm -> semi_minor = core -> accuracy.semiMinor;
+	bsm -> orientation = core -> accuracy.orientation;
+	bsm -> transmission = core -> transmission;
+	bsm -> speed = core -> speed;
+	bsm -> heading = core -> heading;
+	bsm -> angle = core -> angle;
+	bsm -> accel_longitudinal = core -> accelSet.Long;
+	bsm -> accel_lateral = core -> accelSet.lat;
+	bsm -> accel_vert = core -> accelSet.vert;
+	bsm -> accel_yaw_rate = core -> accelSet.yaw;
+	// asn1c keeps the 5 bit wheel brake status in the upper bits of the first byte
+	bsm -> wheel_brakes = core -> brakes.wheelBrakes.buf[0] >> 3;
+	bsm -> traction = core -> brakes.traction;
+	bsm -> abs = core -> brakes.abs;
+	bsm -> scs = core -> brakes.scs;
+	bsm -> brake_boost = core -> brakes.brakeBoost;
+	bsm -> aux_brakes = core -> brakes.auxBrakes;
+	bsm -> vehicle_width = core -> size.width;
+	bsm -> vehicle_length = core -> size.length;
+
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+	return 0;
+}
+
+int j2735_decode_spat(const uint8_t *data, size_t length, j2735_spat_t *spat) {
+	MessageFrame_t *message = decode_frame(data, length, MessageFrame__value_PR_SPAT);
+	if(!message) {
+		return -1;
+	}
+	if(message -> value.choice.SPAT.intersections.list.count < 1) {
+		ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+		return -1;
+	}
+
+	spat -> time_stamp_exists = message -> value.choice.SPAT.timeStamp != NULL;
+	spat -> time_stamp = spat -> time_stamp_exists ? *message -> value.choice.SPAT.timeStamp : 0;
+
+	IntersectionState_t *intersection = message -> value.choice.SPAT.intersections.list.array[0];
+	spat -> intersection_id = intersection -> id.id;
+	spat -> revision = intersection -> revision;
+	spat -> moy_exists = intersection -> moy != NULL;
+	spat -> moy = spat -> moy_exists ? *intersection -> moy : 0;
+	spat -> intersection_time_stamp_exists = intersection -> timeStamp != NULL;
+	spat -> intersection_time_stamp = spat -> intersection_time_stamp_exists ? *intersection -> timeStamp : 0;
+
+	int num_states = intersection -> states.list.count;
+	if(num_states > J2735_MAX_MOVEMENT_STATES) {
+		num_states = J2735_MAX_MOVEMENT_STATES;
+	}
+	spat -> state_count = num_states;
+	for(int i = 0; i < num_states; i++) {
+		MovementState_t *state = intersection -> states.list.array[i];
+		j2735_movement_state_t *out_state = &spat -> states[i];
+		out_state -> signal_group = state -> signalGroup;
+
+		int num_events = state -> state_time_speed.list.count;
+		if(num_events > J2735_MAX_MOVEMENT_EVENTS) {
+			num_events = J2735_MAX_MOVEMENT_EVENTS;
+		}
+		out_state -> event_count = num_events;
+		for(int j = 0; j < num_events; j++) {
+			MovementEvent_t *event = state -> state_time_speed.list.array[j];
+			j2735_movement_event_t *out_event = &out_state -> events[j];
+			memset(out_event, 0, sizeof(*out_event));
+			out_event -> event_state = event -> eventState;
+			if(event -> timing) {
+				out_event -> timing_exists = 1;
+				if(event -> timing -> startTime) {
+					out_event -> start_time = *event -> timing -> startTime;
+					out_event -> start_time_exists = 1;
+				}
+				out_event -> min_end_time = event -> timing -> minEndTime;
+				if(event -> timing -> maxEndTime) {
+					out_event -> max_end_time = *event -> timing -> maxEndTime;
+					out_event -> max_end_time_exists = 1;
+				}
+				if(event -> timing -> nextTime) {
+					out_event -> next_time = *event -> timing -> nextTime;
+					out_event -> next_time_exists = 1;
+				}
+			}
+		}
+	}
+
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+	return 0;
+}
+
+/**
+ * Copy a node offset into the native representation. Returns 0 for unsupported offset types.
+ */
+static int decode_node(const NodeXY_t *node, j2735_node_t *out_node) {
+	switch(node -> delta.present) {
+	case NodeOffsetPointXY_PR_node_XY1:
+		out_node -> type = J2735_NODE_XY1;
+		out_node -> x = node -> delta.choice.node_XY1.x;
+		out_node -> y = node -> delta.choice.node_XY1.y;
+		return 1;
+	case NodeOffsetPointXY_PR_node_XY2:
+		out_node -> type = J2735_NODE_XY2;
+		out_node -> x = node -> delta.choice.node_XY2.x;
+		out_node -> y = node -> delta.choice.node_XY2.y;
+		return 1;
+	case NodeOffsetPointXY_PR_node_XY3:
+		out_node -> type = J2735_NODE_XY3;
+		out_node -> x = node -> delta.choice.node_XY3.x;
+		out_node -> y = node -> delta.choice.node_XY3.y;
+		return 1;
+	case NodeOffsetPointXY_PR_node_XY4:
+		out_node -> type = J2735_NODE_XY4;
+		out_node -> x = node -> delta.choice.node_XY4.x;
+		out_node -> y = node -> delta.choice.node_XY4.y;
+		return 1;
+	case NodeOffsetPointXY_PR_node_XY5:
+		out_node -> type = J2735_NODE_XY5;
+		out_node -> x = node -> delta.choice.node_XY5.x;
+		out_node -> y = node -> delta.choice.node_XY5.y;
+		return 1;
+	case NodeOffsetPointXY_PR_node_XY6:
+		out_node -> type = J2735_NODE_XY6;
+		out_node -> x = node -> delta.choice.node_XY6.x;
+		out_node -> y = node -> delta.choice.node_XY6.y;
+		return 1;
+	case NodeOffsetPointXY_PR_node_LatLon:
+		out_node -> type = J2735_NODE_LATLON;
+		out_node -> x = node -> delta.choice.node_LatLon.lat;
+		out_node -> y = node -> delta.choice.node_LatLon.lon;
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+int j2735_decode_map(const uint8_t *data, size_t length, j2735_map_t *map) {
+	MessageFrame_t *message = decode_frame(data, length, MessageFrame__value_PR_MapData);
+	if(!message) {
+		return -1;
+	}
+
+	map -> msg_issue_revision = message -> value.choice.MapData.msgIssueRevision;
+	map -> intersection_exists = message -> value.choice.MapData.intersections && message -> value.choice.MapData.intersections -> list.count >= 1;
+	map -> lane_count = 0;
+	if(!map -> intersection_exists) {
+		ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+		return 0;
+	}
+
+	IntersectionGeometry_t *intersection = message -> value.choice.MapData.intersections -> list.array[0];
+	map -> intersection_id = intersection -> id.id;
+	map -> revision = intersection -> revision;
+	map -> latitude = intersection -> refPoint.lat;
+	map -> longitude = intersection -> refPoint.Long;
+	map -> elevation_exists = intersection -> refPoint.elevation != NULL;
+	map -> elevation = map -> elevation_exists ? *intersection -> refPoint.elevation : 0;
+	map -> lane_width_exists = intersection -> laneWidth != NULL;
+	map -> lane_width = map -> lane_width_exists ? *intersection -> laneWidth : 0;
+
+	int num_lanes = intersection -> laneSet.list.count;
+	if(num_lanes > J2735_MAX_LANES) {
+		num_lanes = J2735_MAX_LANES;
+	}
+	map -> lane_count = num_lanes;
+	for(int i = 0; i < num_lanes; i++) {
+		GenericLane_t *lane = intersection -> laneSet.list.array[i];
+		j2735_lane_t *out_lane = &map -> lanes[i];
+		out_lane -> lane_id = lane -> laneID;
+		out_lane -> ingress_approach_exists = lane -> ingressApproach != NULL;
+		out_lane -> ingress_approach = out_lane -> ingress_approach_exists ? *lane -> ingressApproach : 0;
+		out_lane -> egress_approach_exists = lane -> egressApproach != NULL;
+		out_lane -> egress_approach = out_lane -> egress_approach_exists ? *lane -> egressApproach : 0;
+		// asn1c keeps the 2 bit directional use in the upper bits of the first byte
+		out_lane -> lane_direction = lane -> laneAttributes.directionalUse.size > 0 ? lane -> laneAttributes.directionalUse.buf[0] >> 6 : 0;
+		// asn1c lane type choices start from 1
+		out_lane -> lane_type = lane -> laneAttributes.laneType.present > 0 ? lane -> laneAttributes.laneType.present - 1 : 0;
+
+		out_lane -> node_count = 0;
+		if(lane -> nodeList.present == NodeListXY_PR_nodes) {
+			int num_nodes = lane -> nodeList.choice.nodes.list.count;
+			for(int j = 0; j < num_nodes && out_lane -> node_count < J2735_MAX_NODES; j++) {
+				out_lane -> node_count += decode_node(lane -> nodeList.choice.nodes.list.array[j], &out_lane -> nodes[out_lane -> node_count]);
+			}
+		}
+
+		out_lane -> connection_count = 0;
+		if(lane -> connectsTo) {
+			int num_connections = lane -> connectsTo -> list.count;
+			if(num_connections > J2735_MAX_CONNECTIONS) {
+				num_connections = J2735_MAX_CONNECTIONS;
+			}
+			out_lane -> connection_count = num_connections;
+			for(int j = 0; j < num_connections; j++) {
+				Connection_t *connection = lane -> connectsTo -> list.array[j];
+				out_lane -> connections[j].connecting_lane = connection -> connectingLane.lane;
+				out_lane -> connections[j].signal_group_exists = connection -> signalGroup != NULL;
+				out_lane -> connections[j].signal_group = connection -> signalGroup ? *connection -> signalGroup : 0;
+			}
+		}
+	}
+
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+	return 0;
+}
+
+static int get_octets(const OCTET_STRING_t *octets, uint8_t *content, size_t max_size, uint8_t *size) {
+	if(octets -> size > max_size) {
+		return -1;
+	}
+	memcpy(content, octets -> buf, octets -> size);
+	*size = (uint8_t) octets -> size;
+	return 0;
+}
+
+static int get_fixed(const OCTET_STRING_t *octets, uint8_t *content, size_t size) {
+	if(octets -> size != size) {
+		return -1;
+	}
+	memcpy(content, octets -> buf, size);
+	return 0;
+}
+
+static int get_header(const MobilityHeader_t *header, j2735_mobility_header_t *out) {
+	if(get_octets(&header -> hostStaticId, out -> sender_id, J2735_STATIC_ID_MAX_LENGTH, &out -> sender_id_length) != 0 ||
+	   get_octets(&header -> targetStaticId, out -> target_id, J2735_STATIC_ID_MAX_LENGTH, &out -> target_id_length) != 0 ||
+	   get_fixed(&header -> hostBSMId, out -> sender_bsm_id, J2735_BSM_ID_LENGTH) != 0 ||
+	   get_fixed(&header -> planId, out -> plan_id, J2735_PLAN_ID_LENGTH) != 0 ||
+	   get_fixed(&header -> timestamp, out -> timestamp, J2735_TIMESTAMP_LENGTH) != 0) {
+		return -1;
+	}
+	return 0;
+}
+
+static int get_location(const MobilityLocation_t *location, j2735_mobility_location_t *out) {
+	out -> ecef_x = location -> ecefX;
+	out -> ecef_y = location -> ecefY;
+	out -> ecef_z = location -> ecefZ;
+	return get_fixed(&location -> timestamp, out -> timestamp, J2735_TIMESTAMP_LENGTH);
+}
+
+static int get_trajectory(const MobilityLocationOffsets_t *trajectory, j2735_mobility_trajectory_t *out) {
+	if(trajectory -> list.count < 0 || trajectory -> list.count > J2735_MAX_TRAJECTORY_OFFSETS) {
+		return -1;
+	}
+	memset(out, 0, sizeof(*out));
+	out -> count = trajectory -> list.count;
+	for(int i = 0; i < trajectory -> list.count; i++) {
+		out -> offset_x[i] = trajectory -> list.array[i] -> offsetX;
+		out -> offset_y[i] = trajectory -> list.array[i] -> offsetY;
+		out -> offset_z[i] = trajectory -> list.array[i] -> offsetZ;
+	}
+	return 0;
+}
+
+int j2735_decode_mobility_request(const uint8_t *data, size_t length, j2735_mobility_request_t *request) {
+	MessageFrame_t *message = decode_frame(data, length, MessageFrame__value_PR_TestMessage00);
+	if(!message) {
+		return -1;
+	}
+	MobilityRequest_t *body = &message -> value.choice.TestMessage00.body;
+	int res = get_header(&message -> value.choice.TestMessage00.header, &request -> header);
+	res |= get_octets(&body -> strategy, request -> strategy, J2735_STRATEGY_MAX_LENGTH, &request -> strategy_length);
+	request -> plan_type = body -> planType;
+	request -> urgency = body -> urgency;
+	res |= get_location(&body -> location, &request -> location);
+	res |= get_octets(&body -> strategyParams, request -> strategy_params, J2735_STRATEGY_PARAMS_MAX_LENGTH, &request -> strategy_params_length);
+
+	//The following fields are optional and zeroed when absent
+	memset(&request -> trajectory_start, 0, sizeof(request -> trajectory_start));
+	memset(&request -> trajectory, 0, sizeof(request -> trajectory));
+	memset(request -> expiration, 0, sizeof(request -> expiration));
+	request -> trajectory_start_exists = body -> trajectoryStart != NULL;
+	if(body -> trajectoryStart) {
+		res |= get_location(body -> trajectoryStart, &request -> trajectory_start);
+	}
+	if(body -> trajectory) {
+		res |= get_trajectory(body -> trajectory, &request -> trajectory);
+	}
+	request -> expiration_exists = body -> expiration != NULL;
+	if(body -> expiration) {
+		res |= get_fixed(body -> expiration, request -> expiration, J2735_TIMESTAMP_LENGTH);
+	}
+
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+	return res == 0 ? 0 : -1;
+}
+
+int j2735_decode_mobility_response(const uint8_t *data, size_t length, j2735_mobility_response_t *response) {
+	MessageFrame_t *message = decode_frame(data, length, MessageFrame__value_PR_TestMessage01);
+	if(!message) {
+		return -1;
+	}
+	int res = get_header(&message -> value.choice.TestMessage01.header, &response -> header);
+	response -> urgency = message -> value.choice.TestMessage01.body.urgency;
+	response -> is_accepted = message -> value.choice.TestMessage01.body.isAccepted;
+
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+	return res == 0 ? 0 : -1;
+}
+
+int j2735_decode_mobility_path(const uint8_t *data, size_t length, j2735_mobility_path_t *path) {
+	MessageFrame_t *message = decode_frame(data, length, MessageFrame__value_PR_TestMessage02);
+	if(!message) {
+		return -1;
+	}
+	int res = get_header(&message -> value.choice.TestMessage02.header, &path -> header);
+	res |= get_location(&message -> value.choice.TestMessage02.body.location, &path -> location);
+	res |= get_trajectory(&message -> value.choice.TestMessage02.body.trajectory, &path -> trajectory);
+
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+	return res == 0 ? 0 : -1;
+}
+
+int j2735_decode_mobility_operation(const uint8_t *data, size_t length, j2735_mobility_operation_t *operation) {
+	MessageFrame_t *message = decode_frame(data, length, MessageFrame__value_PR_TestMessage03);
+	if(!message) {
+		return -1;
+	}
+	int res = get_header(&message -> value.choice.TestMessage03.header, &operation -> header);
+	res |= get_octets(&message -> value.choice.TestMessage03.body.strategy, operation -> strategy,
+	                  J2735_STRATEGY_MAX_LENGTH, &operation -> strategy_length);
+	res |= get_octets(&message -> value.choice.TestMessage03.body.operationParams, operation -> strategy_params,
+	                  J2735_STRATEGY_PARAMS_MAX_LENGTH, &operation -> strategy_params_length);
+
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, message);
+	return res == 0 ? 0 : -1;
+}
+
+/**
+ * Output of an encoder. Bytes past the end of the buffer are only counted so the required size is known.
+ */
+typedef struct encode_output {
+	uint8_t *buffer;
+	size_t buffer_size;
+	size_t length;
+} encode_output_t;
+
+static int write_output(const void *data, size_t size, void *key) {
+	encode_output_t *output = (encode_output_t *) key;
+	if(output -> length < output -> buffer_size) {
+		size_t available = output -> buffer_size - output -> length;
+		memcpy(output -> buffer + output -> length, data, size < available ? size : available);
+	}
+	output -> length += size;
+	return 0;
+}
+
+static ssize_t encode_frame(MessageFrame_t *message, uint8_t *buffer, size_t buffer_size) {
+	encode_output_t output = {buffer, buffer_size, 0};
+	asn_enc_rval_t ec = uper_encode(&asn_DEF_MessageFrame, 0, message, write_output, &output);
+	if(ec.encoded == -1) {
+		return -1;
+	}
+	return (ssize_t) output.length;
+}
+
+/*
+ * Per thread encoder state.
+ * The frames start zeroed like the calloc'ed frames of the JNI encoders and are overwritten field by field for each message.
+ * Their buffers point into the input structures only while encoding, so the frames must never be freed with ASN_STRUCT_FREE.
+ */
+typedef struct trajectory_storage {
+	MobilityLocationOffsets_t trajectory;
+	MobilityECEFOffset_t offsets[J2735_MAX_TRAJECTORY_OFFSETS];
+	MobilityECEFOffset_t *offset_list[J2735_MAX_TRAJECTORY_OFFSETS];
+} trajectory_storage_t;
+
+static __thread MessageFrame_t bsm_frame;
+static __thread uint8_t bsm_wheel_brakes[1];
+static __thread MessageFrame_t request_frame;
+static __thread MobilityLocation_t request_trajectory_start;
+static __thread MobilityTimestamp_t request_expiration;
+static __thread trajectory_storage_t request_trajectory;
+static __thread MessageFrame_t response_frame;
+static __thread MessageFrame_t path_frame;
+static __thread trajectory_storage_t path_trajectory;
+static __thread MessageFrame_t operation_frame;
+
+static void set_octets(OCTET_STRING_t *octets, const uint8_t *content, size_t size) {
+	octets -> buf = (uint8_t *) content;
+	octets -> size = size;
+}
+
+static int set_header(MobilityHeader_t *header, const j2735_mobility_header_t *in) {
+	if(in -> sender_id_length > J2735_STATIC_ID_MAX_LENGTH || in -> target_id_length > J2735_STATIC_ID_MAX_LENGTH) {
+		return -1;
+	}
+	set_octets(&header -> hostStaticId, in -> sender_id, in -> sender_id_length);
+	set_octets(&header -> targetStaticId, in -> target_id, in -> target_id_length);
+	set_octets(&header -> hostBSMId, in -> sender_bsm_id, J2735_BSM_ID_LENGTH);
+	set_octets(&header -> planId, in -> plan_id, J2735_PLAN_ID_LENGTH);
+	set_octets(&header -> timestamp, in -> timestamp, J2735_TIMESTAMP_LENGTH);
+	return 0;
+}
+
+static void set_location(MobilityLocation_t *location, const j2735_mobility_location_t *in) {
+	location -> ecefX = in -> ecef_x;
+	location -> ecefY = in -> ecef_y;
+	location -> ecefZ = in -> ecef_z;
+	set_octets(&location -> timestamp, in -> timestamp, J2735_TIMESTAMP_LENGTH);
+}
+
+/**
+ * Point the offset list of a trajectory at the per thread offsets instead of adding allocated elements
+ */
+static int set_trajectory(MobilityLocationOffsets_t *trajectory, trajectory_storage_t *storage, const j2735_mobility_trajectory_t *in) {
+	if(in -> count > J2735_MAX_TRAJECTORY_OFFSETS) {
+		return -1;
+	}
+	for(int i = 0; i < in -> count; i++) {
+		storage -> offsets[i].offsetX = in -> offset_x[i];
+		storage -> offsets[i].offsetY = in -> offset_y[i];
+		storage -> offsets[i].offsetZ = in -> offset_z[i];
+		storage -> offset_list[i] = &storage -> offsets[i];
+	}
+	trajectory -> list.array = storage -> offset_list;
+	trajectory -> list.count = in -> count;
+	trajectory -> list.size = J2735_MAX_TRAJECTORY_OFFSETS;
+	return 0;
+}
+
+ssize_t j2735_encode_bsm(const j2735_bsm_core_t *bsm, uint8_t *buffer, size_t buffer_size) {
+	MessageFrame_t *message = &bsm_frame;
+	BSMcoreData_t *core = &message -> value.choice.BasicSafetyMessage.coreData;
+	message -> messageId = 20;
+	message -> value.present = MessageFrame__value_PR_BasicSafetyMessage;
+
+	core -> msgCnt = bsm -> msg_count;
+	set_octets(&core -> id, bsm -> id, sizeof(bsm -> id));
+	core -> secMark = bsm -> sec_mark;
+	core -> lat = bsm -> latitude;
+	core -> Long = bsm -> longitude;
+	core -> elev = bsm -> elevation;
+	core -> accuracy.semiMajor = bsm -> semi_major;
+	core -> accuracy.semiMinor = bsm -> semi_minor;
+	core -> accuracy.orientation = bsm -> orientation;
+	core -> transmission = bsm -> transmission;
+	core -> speed = bsm -> speed;
+	core -> heading = bsm -> heading;
+	core -> angle = bsm -> angle;
+	core -> accelSet.Long = bsm -> accel_longitudinal;
+	core -> accelSet.lat = bsm -> accel_lateral;
+	core -> accelSet.vert = bsm -> accel_vert;
+	core -> accelSet.yaw = bsm -> accel_yaw_rate;
+	// asn1c keeps the 5 bit wheel brake status in the upper bits of the first byte
+	bsm_wheel_brakes[0] = bsm -> wheel_brakes << 3;
+	core -> brakes.wheelBrakes.buf = bsm_wheel_brakes;
+	core -> brakes.wheelBrakes.size = 1;
+	core -> brakes.wheelBrakes.bits_unused = 3;
+	core -> brakes.traction = bsm -> traction;
+	core -> brakes.abs = bsm -> abs;
+	core -> brakes.scs = bsm -> scs;
+	core -> brakes.brakeBoost = bsm -> brake_boost;
+	core -> brakes.auxBrakes = bsm -> aux_brakes;
+	core -> size.width = bsm -> vehicle_width;
+	core -> size.length = bsm -> vehicle_length;
+
+	return encode_frame(message, buffer, buffer_size);
+}
+
+ssize_t j2735_encode_mobility_request(const j2735_mobility_request_t *request, uint8_t *buffer, size_t buffer_size) {
+	MessageFrame_t *message = &request_frame;
+	MobilityRequest_t *body = &message -> value.choice.TestMessage00.body;
+	message -> messageId = 240;
+	message -> value.present = MessageFrame__value_PR_TestMessage00;
+	if(set_header(&message -> value.choice.TestMessage00.header, &request -> header) != 0 ||
+	   request -> strategy_length > J2735_STRATEGY_MAX_LENGTH ||
+	   request -> strategy_params_length > J2735_STRATEGY_PARAMS_MAX_LENGTH) {
+		return -1;
+	}
+
+	set_octets(&body -> strategy, request -> strategy, request -> strategy_length);
+	body -> planType = request -> plan_type;
+	body -> urgency = request -> urgency;
+	set_location(&body -> location, &request -> location);
+	set_octets(&body -> strategyParams, request -> strategy_params, request -> strategy_params_length);
+
+	//The following fields are optional
+	body -> trajectoryStart = NULL;
+	body -> trajectory = NULL;
+	if(request -> trajectory_start_exists) {
+		set_location(&request_trajectory_start, &request -> trajectory_start);
+		body -> trajectoryStart = &request_trajectory_start;
+		if(request -> trajectory.count > 0) {
+			if(set_trajectory(&request_trajectory.trajectory, &request_trajectory, &request -> trajectory) != 0) {
+				return -1;
+			}
+			body -> trajectory = &request_trajectory.trajectory;
+		}
+	}
+	body -> expiration = NULL;
+	if(request -> expiration_exists) {
+		set_octets(&request_expiration, request -> expiration, J2735_TIMESTAMP_LENGTH);
+		body -> expiration = &request_expiration;
+	}
+
+	return encode_frame(message, buffer, buffer_size);
+}
+
+ssize_t j2735_encode_mobility_response(const j2735_mobility_response_t *response, uint8_t *buffer, size_t buffer_size) {
+	MessageFrame_t *message = &response_frame;
+	message -> messageId = 241;
+	message -> value.present = MessageFrame__value_PR_TestMessage01;
+	if(set_header(&message -> value.choice.TestMessage01.header, &response -> header) != 0) {
+		return -1;
+	}
+	message -> value.choice.TestMessage01.body.urgency = response -> urgency;
+	message -> value.choice.TestMessage01.body.isAccepted = response -> is_accepted;
+
+	return encode_frame(message, buffer, buffer_size);
+}
+
+ssize_t j2735_encode_mobility_path(const j2735_mobility_path_t *path, uint8_t *buffer, size_t buffer_size) {
+	MessageFrame_t *message = &path_frame;
+	message -> messageId = 242;
+	message -> value.present = MessageFrame__value_PR_TestMessage02;
+	if(set_header(&message -> value.choice.TestMessage02.header, &path -> header) != 0 ||
+	   set_trajectory(&message -> value.choice.TestMessage02.body.trajectory, &path_trajectory, &path -> trajectory) != 0) {
+		return -1;
+	}
+	set_location(&message -> value.choice.TestMessage02.body.location, &path -> location);
+
+	return encode_frame(message, buffer, buffer_size);
+}
+
+ssize_t j2735_encode_mobility_operation(const j2735_mobility_operation_t *operation, uint8_t *buffer, size_t buffer_size) {
+	MessageFrame_t *message = &operation_frame;
+	message -> messageId = 243;
+	message -> value.present = MessageFrame__value_PR_TestMessage03;
+	if(set_header(&message -> value.choice.TestMessage03.header, &operation -> header) != 0 ||
+	   operation -> strategy_length > J2735_STRATEGY_MAX_LENGTH ||
+	   operation -> strategy_params_length > J2735_STRATEGY_PARAMS_MAX_LENGTH) {
+		return -1;
+	}
+	set_octets(&message -> value.choice.TestMessage03.body.strategy, operation -> strategy, operation -> strategy_length);
+	set_octets(&message -> value.choice.TestMessage03.body.operationParams, operation -> strategy_params, operation -> strategy_params_length);
+
+	return encode_frame(message, buffer, buffer_size);
+}
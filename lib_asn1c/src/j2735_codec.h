@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/*
+ * Native J2735 codec:
+ * Plain C entry points over the asn1c MessageFrame types, used by j2735_convertor and by the buffer based
+ * JNI methods of the mobility messages in wrapper.c.
+ * The decoders extract the same fields as the JNI decoders in wrapper.c into caller owned structures,
+ * so no asn1c type is exposed and no memory has to be released by the caller.
+ * The decoders return 0 on success and -1 when the input can not be decoded as the requested message type.
+ *
+ * The encoders take the same structures and write UPER encoded MessageFrames
+ * into caller provided buffers. Each thread reuses one pre-initialized MessageFrame per message type which only
+ * borrows the input buffers while encoding, so no frame or nested structure is allocated per message.
+ * They return the encoded length in bytes, or -1 when the input can not be encoded. A length larger than
+ * buffer_size means the buffer was too small and the call should be repeated with a buffer of that size.
+ */
+
+#ifndef _J2735_CODEC_H
+#define _J2735_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define J2735_MAX_MOVEMENT_STATES 255
+#define J2735_MAX_MOVEMENT_EVENTS 16
+#define J2735_MAX_LANES 255
+#define J2735_MAX_NODES 63
+#define J2735_MAX_CONNECTIONS 16
+
+/* Mobility message field sizes, matching the buffers of the Java message factories */
+#define J2735_STATIC_ID_MAX_LENGTH 16
+#define J2735_BSM_ID_LENGTH 8
+#define J2735_PLAN_ID_LENGTH 36
+#define J2735_TIMESTAMP_LENGTH 19
+#define J2735_STRATEGY_MAX_LENGTH 50
+#define J2735_STRATEGY_PARAMS_MAX_LENGTH 100
+#define J2735_MAX_TRAJECTORY_OFFSETS 60
+
+/* Node offset types, matching the node type values used by the JNI MAP decoder */
+#define J2735_NODE_XY1 1
+#define J2735_NODE_XY2 2
+#define J2735_NODE_XY3 3
+#define J2735_NODE_XY4 4
+#define J2735_NODE_XY5 5
+#define J2735_NODE_XY6 6
+#define J2735_NODE_LATLON 7
+
+typedef struct j2735_bsm_core {
+	uint8_t msg_count;
+	uint8_t id[4];
+	uint16_t sec_mark;
+	int32_t latitude;
+	int32_t longitude;
+	int32_t elevation;
+	uint8_t semi_major;
+	uint8_t semi_minor;
+	uint16_t orientation;
+	uint8_t transmission;
+	uint16_t speed;
+	uint16_t heading;
+	int8_t angle;
+	int16_t accel_longitudinal;
+	int16_t accel_lateral;
+	int8_t accel_vert;
+	int16_t accel_yaw_rate;
+	uint8_t wheel_brakes; /* Bit string shifted down to its 5 significant bits */
+	uint8_t traction;
+	uint8_t abs;
+	uint8_t scs;
+	uint8_t brake_boost;
+	uint8_t aux_brakes;
+	uint16_t vehicle_width;
+	uint16_t vehicle_length;
+} j2735_bsm_core_t;
+
+typedef struct j2735_movement_event {
+	uint8_t event_state;
+	uint8_t timing_exists;
+	uint16_t start_time;
+	uint8_t start_time_exists;
+	uint16_t min_end_time;
+	uint16_t max_end_time;
+	uint8_t max_end_time_exists;
+	uint16_t next_time;
+	uint8_t next_time_exists;
+} j2735_movement_event_t;
+
+typedef struct j2735_movement_state {
+	uint8_t signal_group;
+	uint8_t event_count;
+	j2735_movement_event_t events[J2735_MAX_MOVEMENT_EVENTS];
+} j2735_movement_state_t;
+
+/* As in the JNI decoder only the first intersection of a SPAT is decoded */
+typedef struct j2735_spat {
+	uint32_t time_stamp;
+	uint8_t time_stamp_exists;
+	uint16_t intersection_id;
+	uint8_t revision;
+	uint32_t moy;
+	uint8_t moy_exists;
+	uint16_t intersection_time_stamp;
+	uint8_t intersection_time_stamp_exists;
+	uint16_t state_count;
+	j2735_movement_state_t states[J2735_MAX_MOVEMENT_STATES];
+} j2735_spat_t;
+
+typedef struct j2735_node {
+	uint8_t type; /* One of J2735_NODE_*, x and y hold latitude and longitude for J2735_NODE_LATLON */
+	int32_t x;
+	int32_t y;
+} j2735_node_t;
+
+typedef struct j2735_connection {
+	uint8_t connecting_lane;
+	uint8_t signal_group;
+	uint8_t signal_group_exists;
+} j2735_connection_t;
+
+typedef struct j2735_lane {
+	uint8_t lane_id;
+	uint8_t ingress_approach;
+	uint8_t ingress_approach_exists;
+	uint8_t egress_approach;
+	uint8_t egress_approach_exists;
+	uint8_t lane_direction; /* Directional use bits, 0b10 ingress and 0b01 egress */
+	uint8_t lane_type; /* Zero based lane type choice */
+	uint8_t node_count;
+	j2735_node_t nodes[J2735_MAX_NODES];
+	uint8_t connection_count;
+	j2735_connection_t connections[J2735_MAX_CONNECTIONS];
+} j2735_lane_t;
+
+/* As in the JNI decoder only the first intersection of a MAP is decoded */
+typedef struct j2735_map {
+	uint8_t msg_issue_revision;
+	uint8_t intersection_exists;
+	uint16_t intersection_id;
+	uint8_t revision;
+	int32_t latitude;
+	int32_t longitude;
+	int32_t elevation;
+	uint8_t elevation_exists;
+	uint16_t lane_width;
+	uint8_t lane_width_exists;
+	uint16_t lane_count;
+	j2735_lane_t lanes[J2735_MAX_LANES];
+} j2735_map_t;
+
+typedef struct j2735_mobility_header {
+	uint8_t sender_id[J2735_STATIC_ID_MAX_LENGTH];
+	uint8_t sender_id_length;
+	uint8_t target_id[J2735_STATIC_ID_MAX_LENGTH];
+	uint8_t target_id_length;
+	uint8_t sender_bsm_id[J2735_BSM_ID_LENGTH];
+	uint8_t plan_id[J2735_PLAN_ID_LENGTH];
+	uint8_t timestamp[J2735_TIMESTAMP_LENGTH];
+} j2735_mobility_header_t;
+
+typedef struct j2735_mobility_location {
+	int32_t ecef_x;
+	int32_t ecef_y;
+	int32_t ecef_z;
+	uint8_t timestamp[J2735_TIMESTAMP_LENGTH];
+} j2735_mobility_location_t;
+
+typedef struct j2735_mobility_trajectory {
+	uint8_t count;
+	int32_t offset_x[J2735_MAX_TRAJECTORY_OFFSETS];
+	int32_t offset_y[J2735_MAX_TRAJECTORY_OFFSETS];
+	int32_t offset_z[J2735_MAX_TRAJECTORY_OFFSETS];
+} j2735_mobility_trajectory_t;
+
+typedef struct j2735_mobility_request {
+	j2735_mobility_header_t header;
+	uint8_t strategy[J2735_STRATEGY_MAX_LENGTH];
+	uint8_t strategy_length;
+	int32_t plan_type;
+	int32_t urgency;
+	j2735_mobility_location_t location;
+	uint8_t strategy_params[J2735_STRATEGY_PARAMS_MAX_LENGTH];
+	uint8_t strategy_params_length;
+	uint8_t trajectory_start_exists;
+	j2735_mobility_location_t trajectory_start;
+	j2735_mobility_trajectory_t trajectory; /* Only encoded together with trajectory_start and when not empty */
+	uint8_t expiration_exists;
+	uint8_t expiration[J2735_TIMESTAMP_LENGTH];
+} j2735_mobility_request_t;
+
+typedef struct j2735_mobility_response {
+	j2735_mobility_header_t header;
+	int32_t urgency;
+	uint8_t is_accepted;
+} j2735_mobility_response_t;
+
+typedef struct j2735_mobility_path {
+	j2735_mobility_header_t header;
+	j2735_mobility_location_t location;
+	j2735_mobility_trajectory_t trajectory;
+} j2735_mobility_path_t;
+
+typedef struct j2735_mobility_operation {
+	j2735_mobility_header_t header;
+	uint8_t strategy[J2735_STRATEGY_MAX_LENGTH];
+	uint8_t strategy_length;
+	uint8_t strategy_params[J2735_STRATEGY_PARAMS_MAX_LENGTH];
+	uint8_t strategy_params_length;
+} j2735_mobility_operation_t;
+
+/**
+ * Decode a UPER encoded MessageFrame holding a BasicSafetyMessage
+ */
+int j2735_decode_bsm(const uint8_t *data, size_t length, j2735_bsm_core_t *bsm);
+
+/**
+ * Decode a UPER encoded MessageFrame holding a SPAT
+ */
+int j2735_decode_spat(const uint8_t *data, size_t length, j2735_spat_t *spat);
+
+/**
+ * Decode a UPER encoded MessageFrame holding a MapData.
+ * j2735_map_t is large, callers should reuse one instance rather than placing it on the stack.
+ */
+int j2735_decode_map(const uint8_t *data, size_t length, j2735_map_t *map);
+
+/**
+ * Decode a UPER encoded MessageFrame holding a MobilityRequest.
+ * Fields which are longer than the Java message factory buffers fail the decoding.
+ */
+int j2735_decode_mobility_request(const uint8_t *data, size_t length, j2735_mobility_request_t *request);
+
+/**
+ * Decode a UPER encoded MessageFrame holding a MobilityResponse
+ */
+int j2735_decode_mobility_response(const uint8_t *data, size_t length, j2735_mobility_response_t *response);
+
+/**
+ * Decode a UPER encoded MessageFrame holding a MobilityPath
+ */
+int j2735_decode_mobility_path(const uint8_t *data, size_t length, j2735_mobility_path_t *path);
+
+/**
+ * Decode a UPER encoded MessageFrame holding a MobilityOperation
+ */
+int j2735_decode_mobility_operation(const uint8_t *data, size_t length, j2735_mobility_operation_t *operation);
+
+/**
+ * Encode a BasicSafetyMessage into a UPER encoded MessageFrame
+ */
+ssize_t j2735_encode_bsm(const j2735_bsm_core_t *bsm, uint8_t *buffer, size_t buffer_size);
+
+/**
+ * Encode a MobilityRequest into a UPER encoded MessageFrame
+ */
+ssize_t j2735_encode_mobility_request(const j2735_mobility_request_t *request, uint8_t *buffer, size_t buffer_size);
+
+/**
+ * Encode a MobilityResponse into a UPER encoded MessageFrame
+ */
+ssize_t j2735_encode_mobility_response(const j2735_mobility_response_t *response, uint8_t *buffer, size_t buffer_size);
+
+/**
+ * Encode a MobilityPath into a UPER encoded MessageFrame.
+ * Paths with long trajectories may not fit the buffers used for other messages, see the size contract above.
+ */
+ssize_t j2735_encode_mobility_path(const j2735_mobility_path_t *path, uint8_t *buffer, size_t buffer_size);
+
+/**
+ * Encode a MobilityOperation into a UPER encoded MessageFrame
+ */
+ssize_t j2735_encode_mobility_operation(const j2735_mobility_operation_t *operation, uint8_t *buffer, size_t buffer_size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -15,6 +15,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <sys/types.h>
 #include "gov_dot_fhwa_saxton_carma_message_factory_BSMMessage.h"
 #include "gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage.h"
@@ -24,6 +25,208 @@
 #include "gov_dot_fhwa_saxton_carma_message_factory_MapMessage.h"
 #include "gov_dot_fhwa_saxton_carma_message_factory_SPATMessage.h"
 #include "MessageFrame.h"
+#include "j2735_codec.h"
+
+/*
+ * Field buffers of the buffer based mobility methods:
+ * A single direct ByteBuffer carries all fields of a message in the order of the j2735_mobility_* structures,
+ * so the fields cross JNI with one GetDirectBufferAddress call instead of one array copy per field.
+ * Variable length strings take a length byte followed by a slot of their maximum length, fixed length strings
+ * take their length, ints take 4 bytes in native byte order and flags and counts one byte.
+ * Trajectories take a count byte followed by 60 x, 60 y and 60 z offsets. The layout is mirrored by MobilityBuffer.java.
+ * The encoders overwrite the fields with the encoded message, the decoders read the encoded message from the start
+ * of the buffer and overwrite it with the fields.
+ */
+typedef struct field_buffer {
+	uint8_t *data;
+	size_t size;
+	size_t position;
+	int valid;
+} field_buffer_t;
+
+static int get_field_buffer(JNIEnv *env, jobject buffer, field_buffer_t *fields) {
+	fields -> data = (uint8_t *) (*env) -> GetDirectBufferAddress(env, buffer);
+	jlong capacity = (*env) -> GetDirectBufferCapacity(env, buffer);
+	fields -> size = capacity > 0 ? (size_t) capacity : 0;
+	fields -> position = 0;
+	fields -> valid = fields -> data != NULL && fields -> size > 0;
+	return fields -> valid;
+}
+
+static uint8_t *next_field(field_buffer_t *fields, size_t size) {
+	if(!fields -> valid || fields -> size - fields -> position < size) {
+		fields -> valid = 0;
+		return NULL;
+	}
+	uint8_t *field = fields -> data + fields -> position;
+	fields -> position += size;
+	return field;
+}
+
+static void read_bytes(field_buffer_t *fields, uint8_t *content, size_t size) {
+	uint8_t *field = next_field(fields, size);
+	if(field) {
+		memcpy(content, field, size);
+	}
+}
+
+static uint8_t read_byte(field_buffer_t *fields) {
+	uint8_t value = 0;
+	read_bytes(fields, &value, 1);
+	return value;
+}
+
+static int32_t read_int(field_buffer_t *fields) {
+	int32_t value = 0;
+	read_bytes(fields, (uint8_t *) &value, sizeof(value));
+	return value;
+}
+
+static void read_string(field_buffer_t *fields, uint8_t *content, size_t max_length, uint8_t *length) {
+	*length = read_byte(fields);
+	if(*length > max_length) {
+		fields -> valid = 0;
+	}
+	read_bytes(fields, content, max_length);
+}
+
+static void write_bytes(field_buffer_t *fields, const uint8_t *content, size_t size) {
+	uint8_t *field = next_field(fields, size);
+	if(field) {
+		memcpy(field, content, size);
+	}
+}
+
+static void write_byte(field_buffer_t *fields, uint8_t value) {
+	write_bytes(fields, &value, 1);
+}
+
+static void write_int(field_buffer_t *fields, int32_t value) {
+	write_bytes(fields, (const uint8_t *) &value, sizeof(value));
+}
+
+static void write_string(field_buffer_t *fields, const uint8_t *content, size_t max_length, uint8_t length) {
+	write_byte(fields, length);
+	write_bytes(fields, content, max_length);
+}
+
+static void read_header(field_buffer_t *fields, j2735_mobility_header_t *header) {
+	read_string(fields, header -> sender_id, J2735_STATIC_ID_MAX_LENGTH, &header -> sender_id_length);
+	read_string(fields, header -> target_id, J2735_STATIC_ID_MAX_LENGTH, &header -> target_id_length);
+	read_bytes(fields, header -> sender_bsm_id, J2735_BSM_ID_LENGTH);
+	read_bytes(fields, header -> plan_id, J2735_PLAN_ID_LENGTH);
+	read_bytes(fields, header -> timestamp, J2735_TIMESTAMP_LENGTH);
+}
+
+static void write_header(field_buffer_t *fields, const j2735_mobility_header_t *header) {
+	write_string(fields, header -> sender_id, J2735_STATIC_ID_MAX_LENGTH, header -> sender_id_length);
+	write_string(fields, header -> target_id, J2735_STATIC_ID_MAX_LENGTH, header -> target_id_length);
+	write_bytes(fields, header -> sender_bsm_id, J2735_BSM_ID_LENGTH);
+	write_bytes(fields, header -> plan_id, J2735_PLAN_ID_LENGTH);
+	write_bytes(fields, header -> timestamp, J2735_TIMESTAMP_LENGTH);
+}
+
+static void read_location(field_buffer_t *fields, j2735_mobility_location_t *location) {
+	location -> ecef_x = read_int(fields);
+	location -> ecef_y = read_int(fields);
+	location -> ecef_z = read_int(fields);
+	read_bytes(fields, location -> timestamp, J2735_TIMESTAMP_LENGTH);
+}
+
+static void write_location(field_buffer_t *fields, const j2735_mobility_location_t *location) {
+	write_int(fields, location -> ecef_x);
+	write_int(fields, location -> ecef_y);
+	write_int(fields, location -> ecef_z);
+	write_bytes(fields, location -> timestamp, J2735_TIMESTAMP_LENGTH);
+}
+
+static void read_trajectory(field_buffer_t *fields, j2735_mobility_trajectory_t *trajectory) {
+	trajectory -> count = read_byte(fields);
+	if(trajectory -> count > J2735_MAX_TRAJECTORY_OFFSETS) {
+		fields -> valid = 0;
+	}
+	read_bytes(fields, (uint8_t *) trajectory -> offset_x, sizeof(trajectory -> offset_x));
+	read_bytes(fields, (uint8_t *) trajectory -> offset_y, sizeof(trajectory -> offset_y));
+	read_bytes(fields, (uint8_t *) trajectory -> offset_z, sizeof(trajectory -> offset_z));
+}
+
+static void write_trajectory(field_buffer_t *fields, const j2735_mobility_trajectory_t *trajectory) {
+	write_byte(fields, trajectory -> count);
+	write_bytes(fields, (const uint8_t *) trajectory -> offset_x, sizeof(trajectory -> offset_x));
+	write_bytes(fields, (const uint8_t *) trajectory -> offset_y, sizeof(trajectory -> offset_y));
+	write_bytes(fields, (const uint8_t *) trajectory -> offset_z, sizeof(trajectory -> offset_z));
+}
+
+static void read_mobility_request(field_buffer_t *fields, j2735_mobility_request_t *request) {
+	read_header(fields, &request -> header);
+	read_string(fields, request -> strategy, J2735_STRATEGY_MAX_LENGTH, &request -> strategy_length);
+	request -> plan_type = read_int(fields);
+	request -> urgency = read_int(fields);
+	read_location(fields, &request -> location);
+	read_string(fields, request -> strategy_params, J2735_STRATEGY_PARAMS_MAX_LENGTH, &request -> strategy_params_length);
+	request -> trajectory_start_exists = read_byte(fields);
+	read_location(fields, &request -> trajectory_start);
+	read_trajectory(fields, &request -> trajectory);
+	request -> expiration_exists = read_byte(fields);
+	read_bytes(fields, request -> expiration, J2735_TIMESTAMP_LENGTH);
+}
+
+static void write_mobility_request(field_buffer_t *fields, const j2735_mobility_request_t *request) {
+	write_header(fields, &request -> header);
+	write_string(fields, request -> strategy, J2735_STRATEGY_MAX_LENGTH, request -> strategy_length);
+	write_int(fields, request -> plan_type);
+	write_int(fields, request -> urgency);
+	write_location(fields, &request -> location);
+	write_string(fields, request -> strategy_params, J2735_STRATEGY_PARAMS_MAX_LENGTH, request -> strategy_params_length);
+	write_byte(fields, request -> trajectory_start_exists);
+	write_location(fields, &request -> trajectory_start);
+	write_trajectory(fields, &request -> trajectory);
+	write_byte(fields, request -> expiration_exists);
+	write_bytes(fields, request -> expiration, J2735_TIMESTAMP_LENGTH);
+}
+
+static void read_mobility_response(field_buffer_t *fields, j2735_mobility_response_t *response) {
+	read_header(fields, &response -> header);
+	response -> urgency = read_int(fields);
+	response -> is_accepted = read_byte(fields);
+}
+
+static void write_mobility_response(field_buffer_t *fields, const j2735_mobility_response_t *response) {
+	write_header(fields, &response -> header);
+	write_int(fields, response -> urgency);
+	write_byte(fields, response -> is_accepted);
+}
+
+static void read_mobility_path(field_buffer_t *fields, j2735_mobility_path_t *path) {
+	read_header(fields, &path -> header);
+	read_location(fields, &path -> location);
+	read_trajectory(fields, &path -> trajectory);
+}
+
+static void write_mobility_path(field_buffer_t *fields, const j2735_mobility_path_t *path) {
+	write_header(fields, &path -> header);
+	write_location(fields, &path -> location);
+	write_trajectory(fields, &path -> trajectory);
+}
+
+static void read_mobility_operation(field_buffer_t *fields, j2735_mobility_operation_t *operation) {
+	read_header(fields, &operation -> header);
+	read_string(fields, operation -> strategy, J2735_STRATEGY_MAX_LENGTH, &operation -> strategy_length);
+	read_string(fields, operation -> strategy_params, J2735_STRATEGY_PARAMS_MAX_LENGTH, &operation -> strategy_params_length);
+}
+
+static void write_mobility_operation(field_buffer_t *fields, const j2735_mobility_operation_t *operation) {
+	write_header(fields, &operation -> header);
+	write_string(fields, operation -> strategy, J2735_STRATEGY_MAX_LENGTH, operation -> strategy_length);
+	write_string(fields, operation -> strategy_params, J2735_STRATEGY_PARAMS_MAX_LENGTH, operation -> strategy_params_length);
+}
+
+/**
+ * Start decoding a buffer based call. Returns 0 when the encoded message of the given length does not fit the buffer.
+ */
+static int get_encoded_message(JNIEnv *env, jobject buffer, jint length, field_buffer_t *fields) {
+	return get_field_buffer(env, buffer, fields) && length >= 0 && (size_t) length <= fields -> size;
+}
 
 /**
  * BSM Encoder:
@@ -32,12 +235,93 @@
  * Note: In this function, we pass parameters instead of passing a single object,
  * because making the natives to reach for many individual fields
  * from objects passed to them leads to poor performance.
+ * When built with J2735_CODEC_ENCODE_BSM the message is encoded by j2735_encode_bsm,
+ * which reuses one MessageFrame per thread instead of allocating a new one for each message.
  */
 JNIEXPORT jbyteArray JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_BSMMessage_encode_1BSM
 		(JNIEnv *env, jobject cls, jint msgCount, jintArray bsm_id, jint secMark,
 		  jint lat, jint lon, jint elev, jintArray accuracy_set, jint transmission,
 		  jint speed, jint heading, jint angle, jintArray accel_set, jintArray brakes_set, jintArray size_set) {
 
+#ifdef J2735_CODEC_ENCODE_BSM
+	uint8_t buffer[128];
+	j2735_bsm_core_t bsm;
+	memset(&bsm, 0, sizeof(bsm));
+
+	bsm.msg_count = msgCount;
+
+	jint *bsm_msg_id = (*env) -> GetIntArrayElements(env, bsm_id, 0);
+	if(bsm_msg_id == NULL) {
+		return NULL;
+	}
+	for(int i = 0; i < 4; i++) {
+		bsm.id[i] = (uint8_t) bsm_msg_id[i];
+	}
+	(*env) -> ReleaseIntArrayElements(env, bsm_id, bsm_msg_id, 0);
+
+	bsm.sec_mark = secMark;
+	bsm.latitude = lat;
+	bsm.longitude = lon;
+	bsm.elevation = elev;
+
+	jint *accuracy = (*env) -> GetIntArrayElements(env, accuracy_set, 0);
+	if(accuracy == NULL) {
+		return NULL;
+	}
+	bsm.semi_major = accuracy[0];
+	bsm.semi_minor = accuracy[1];
+	bsm.orientation = accuracy[2];
+	(*env) -> ReleaseIntArrayElements(env, accuracy_set, accuracy, 0);
+
+	bsm.transmission = transmission;
+	bsm.speed = speed;
+	bsm.heading = heading;
+	bsm.angle = angle;
+
+	jint *accel = (*env) -> GetIntArrayElements(env, accel_set, 0);
+	if(accel == NULL) {
+		return NULL;
+	}
+	bsm.accel_lateral = accel[0];
+	bsm.accel_longitudinal = accel[1];
+	bsm.accel_vert = accel[2];
+	bsm.accel_yaw_rate = accel[3];
+	(*env) -> ReleaseIntArrayElements(env, accel_set, accel, 0);
+
+	jint *brakes = (*env) -> GetIntArrayElements(env, brakes_set, 0);
+	if(brakes == NULL) {
+		return NULL;
+	}
+	// Java passes the 5 bit wheel brake status in the upper bits of the byte as asn1c stores it
+	bsm.wheel_brakes = (uint8_t) brakes[0] >> 3;
+	bsm.traction = brakes[1];
+	bsm.abs = brakes[2];
+	bsm.scs = brakes[3];
+	bsm.brake_boost = brakes[4];
+	bsm.aux_brakes = brakes[5];
+	(*env) -> ReleaseIntArrayElements(env, brakes_set, brakes, 0);
+
+	jint *size = (*env) -> GetIntArrayElements(env, size_set, 0);
+	if(size == NULL) {
+		return NULL;
+	}
+	bsm.vehicle_width = size[0];
+	bsm.vehicle_length = size[1];
+	(*env) -> ReleaseIntArrayElements(env, size_set, size, 0);
+
+	ssize_t encoded = j2735_encode_bsm(&bsm, buffer, sizeof(buffer));
+	if(encoded == -1 || encoded > (ssize_t) sizeof(buffer)) {
+		return NULL;
+	}
+
+	jsize length = encoded;
+	jbyteArray outJNIArray = (*env) -> NewByteArray(env, length);
+	if(outJNIArray == NULL) {
+		return NULL;
+	}
+	(*env) -> SetByteArrayRegion(env, outJNIArray, 0, length, buffer);
+	return outJNIArray;
+#else
 	uint8_t buffer[128];
 	size_t buffer_size = sizeof(buffer);
 	asn_enc_rval_t ec;
@@ -134,6 +418,7 @@ JNIEXPORT jbyteArray JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_BSMM
 	}
 	(*env) -> SetByteArrayRegion(env, outJNIArray, 0, length, buffer);
 	return outJNIArray;
+#endif
 }
 
 /**
@@ -626,6 +911,44 @@ JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityRe
 	return 0;
 }
 
+/**
+ * MobilityRequest buffer encoder:
+ * Encodes the MobilityRequest fields packed into a direct ByteBuffer and writes the encoded message into the same buffer.
+ * Returns the encoded length, -1 when an error happened, or the required capacity when the message does not fit.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage_encodeMobilityRequestBuffer
+  (JNIEnv *env, jobject obj, jobject buffer) {
+
+	field_buffer_t fields;
+	j2735_mobility_request_t request;
+	if(!get_field_buffer(env, buffer, &fields)) {
+		return -1;
+	}
+	read_mobility_request(&fields, &request);
+	if(!fields.valid) {
+		return -1;
+	}
+	return (jint) j2735_encode_mobility_request(&request, fields.data, fields.size);
+}
+
+/**
+ * MobilityRequest buffer decoder:
+ * Decodes the first length bytes of a direct ByteBuffer and packs the MobilityRequest fields into the same buffer.
+ * Return -1 means an error has happened; return 0 means decoding succeed.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityRequestMessage_decodeMobilityRequestBuffer
+  (JNIEnv *env, jobject obj, jobject buffer, jint length) {
+
+	field_buffer_t fields;
+	j2735_mobility_request_t request;
+	if(!get_encoded_message(env, buffer, length, &fields) ||
+	   j2735_decode_mobility_request(fields.data, length, &request) != 0) {
+		return -1;
+	}
+	write_mobility_request(&fields, &request);
+	return fields.valid ? 0 : -1;
+}
+
 
 /*
  * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage
@@ -864,6 +1187,44 @@ JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityPa
 	}
   }
 
+/**
+ * MobilityPath buffer encoder:
+ * Encodes the MobilityPath fields packed into a direct ByteBuffer and writes the encoded message into the same buffer.
+ * Returns the encoded length, -1 when an error happened, or the required capacity when the message does not fit.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage_encodeMobilityPathBuffer
+  (JNIEnv *env, jobject obj, jobject buffer) {
+
+	field_buffer_t fields;
+	j2735_mobility_path_t path;
+	if(!get_field_buffer(env, buffer, &fields)) {
+		return -1;
+	}
+	read_mobility_path(&fields, &path);
+	if(!fields.valid) {
+		return -1;
+	}
+	return (jint) j2735_encode_mobility_path(&path, fields.data, fields.size);
+}
+
+/**
+ * MobilityPath buffer decoder:
+ * Decodes the first length bytes of a direct ByteBuffer and packs the MobilityPath fields into the same buffer.
+ * Return -1 means an error has happened; return 0 means decoding succeed.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityPathMessage_decodeMobilityPathBuffer
+  (JNIEnv *env, jobject obj, jobject buffer, jint length) {
+
+	field_buffer_t fields;
+	j2735_mobility_path_t path;
+	if(!get_encoded_message(env, buffer, length, &fields) ||
+	   j2735_decode_mobility_path(fields.data, length, &path) != 0) {
+		return -1;
+	}
+	write_mobility_path(&fields, &path);
+	return fields.valid ? 0 : -1;
+}
+
 /*
  * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage
  * Method:    encodeMobilityResponse
@@ -1025,6 +1386,44 @@ JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityRe
 	}
 }
 
+/**
+ * MobilityResponse buffer encoder:
+ * Encodes the MobilityResponse fields packed into a direct ByteBuffer and writes the encoded message into the same buffer.
+ * Returns the encoded length, -1 when an error happened, or the required capacity when the message does not fit.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage_encodeMobilityResponseBuffer
+  (JNIEnv *env, jobject obj, jobject buffer) {
+
+	field_buffer_t fields;
+	j2735_mobility_response_t response;
+	if(!get_field_buffer(env, buffer, &fields)) {
+		return -1;
+	}
+	read_mobility_response(&fields, &response);
+	if(!fields.valid) {
+		return -1;
+	}
+	return (jint) j2735_encode_mobility_response(&response, fields.data, fields.size);
+}
+
+/**
+ * MobilityResponse buffer decoder:
+ * Decodes the first length bytes of a direct ByteBuffer and packs the MobilityResponse fields into the same buffer.
+ * Return -1 means an error has happened; return 0 means decoding succeed.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityResponseMessage_decodeMobilityResponseBuffer
+  (JNIEnv *env, jobject obj, jobject buffer, jint length) {
+
+	field_buffer_t fields;
+	j2735_mobility_response_t response;
+	if(!get_encoded_message(env, buffer, length, &fields) ||
+	   j2735_decode_mobility_response(fields.data, length, &response) != 0) {
+		return -1;
+	}
+	write_mobility_response(&fields, &response);
+	return fields.valid ? 0 : -1;
+}
+
 	/*
 	 * Class:     gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage
 	 * Method:    encodeMobilityOperation
@@ -1208,6 +1607,44 @@ JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityOp
 	}
 }
 
+/**
+ * MobilityOperation buffer encoder:
+ * Encodes the MobilityOperation fields packed into a direct ByteBuffer and writes the encoded message into the same buffer.
+ * Returns the encoded length, -1 when an error happened, or the required capacity when the message does not fit.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage_encodeMobilityOperationBuffer
+  (JNIEnv *env, jobject obj, jobject buffer) {
+
+	field_buffer_t fields;
+	j2735_mobility_operation_t operation;
+	if(!get_field_buffer(env, buffer, &fields)) {
+		return -1;
+	}
+	read_mobility_operation(&fields, &operation);
+	if(!fields.valid) {
+		return -1;
+	}
+	return (jint) j2735_encode_mobility_operation(&operation, fields.data, fields.size);
+}
+
+/**
+ * MobilityOperation buffer decoder:
+ * Decodes the first length bytes of a direct ByteBuffer and packs the MobilityOperation fields into the same buffer.
+ * Return -1 means an error has happened; return 0 means decoding succeed.
+ */
+JNIEXPORT jint JNICALL Java_gov_dot_fhwa_saxton_carma_message_factory_MobilityOperationMessage_decodeMobilityOperationBuffer
+  (JNIEnv *env, jobject obj, jobject buffer, jint length) {
+
+	field_buffer_t fields;
+	j2735_mobility_operation_t operation;
+	if(!get_encoded_message(env, buffer, length, &fields) ||
+	   j2735_decode_mobility_operation(fields.data, length, &operation) != 0) {
+		return -1;
+	}
+	write_mobility_operation(&fields, &operation);
+	return fields.valid ? 0 : -1;
+}
+
 /**
  * Decode Map
  * 
@@ -17,7 +17,10 @@
 #ifndef PLAN_DELEGATOR_INCLUDE_PLAN_DELEGATOR_HPP_
 #define PLAN_DELEGATOR_INCLUDE_PLAN_DELEGATOR_HPP_
 
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <future>
 #include <math.h>
 #include <ros/ros.h>
 #include <cav_msgs/ManeuverPlan.h>
@@ -43,20 +46,47 @@
 
 namespace plan_delegator
 {
+    /**
+     * \brief Trajectory points planned for a single maneuver along with the vehicle state they were requested from
+     */
+    struct TrajectorySegment
+    {
+        cav_msgs::VehicleState start_state;
+        std::vector<cav_msgs::TrajectoryPlanPoint> points;
+    };
+
     class PlanDelegator
     {
         public:
 
             // constants definition
-            static const constexpr double MILLISECOND_TO_SECOND = 0.001;
+            static const constexpr double NANOSECOND_TO_SECOND = 1e-9;
+            // duration over which a boundary correction is faded out when stitching parallel planned segments
+            static const constexpr double BOUNDARY_SMOOTHING_DURATION = 1.0;
 
             PlanDelegator();
 
+            virtual ~PlanDelegator() = default;
+
             /**
              * \brief Initialize the plan delegator
              */
             void init();
 
+            /**
+             * \brief Initialize the plan delegator on the provided node handles, for use inside a nodelet.
+             * Unlike init() this does not register with the CARMANodeHandle spin loop, call startSpinTimer() instead
+             * \param nh Public node handle to subscribe and publish on
+             * \param pnh Private node handle to read parameters from
+             */
+            void init(ros::NodeHandle nh, ros::NodeHandle pnh);
+
+            /**
+             * \brief Trigger planning from a timer on the public node handle's callback queue at the configured spin rate.
+             * Exceptions from planning are reported as a system alert instead of being rethrown into the callback queue
+             */
+            void startSpinTimer();
+
             /**
              * \brief Run the spin loop of plan delegator
              */
@@ -86,20 +116,109 @@ namespace plan_delegator
              */
             cav_srvs::PlanTrajectory composePlanTrajectoryRequest(const cav_msgs::TrajectoryPlan& latest_trajectory_plan) const;
 
+            /**
+             * \brief Generate the vehicle state a new trajectory segment should start from based on current planning progress
+             * \return the current vehicle state if nothing has been planned yet, otherwise the state at the end of the trajectory
+             */
+            cav_msgs::VehicleState composeVehicleState(const cav_msgs::TrajectoryPlan& latest_trajectory_plan) const;
+
+            /**
+             * \brief Move the points of a planned segment onto the end of a trajectory. The first segment is taken over
+             * without copying and capacity for the rest of the trajectory horizon is reserved up front
+             */
+            void appendTrajectoryPoints(cav_msgs::TrajectoryPlan& latest_trajectory_plan, std::vector<cav_msgs::TrajectoryPlanPoint>&& points) const;
+
+            /**
+             * \brief Estimate the vehicle state at the start of a maneuver without waiting for the trajectory of
+             * the preceding maneuver. The remaining distance to the maneuver's start_dist is projected along the
+             * current heading and the speed is taken from its start_speed
+             * \return a VehicleState which can be used to speculatively request the maneuver's trajectory
+             */
+            cav_msgs::VehicleState estimateManeuverStartState(const cav_msgs::Maneuver& maneuver, ros::Time current_time = ros::Time::now()) const;
+
+            /**
+             * \brief Example if a speculatively used vehicle state is close enough to the state actually
+             * reached at the end of the preceding trajectory for the speculative result to be kept
+             * \return if the estimated state is within the configured speculation tolerances
+             */
+            bool isSpeculativeStateConsistent(const cav_msgs::VehicleState& estimated, const cav_msgs::VehicleState& actual) const noexcept;
+
+            /**
+             * \brief Example if planning inputs have changed enough since the last planning cycle to require
+             * a new trajectory. A new maneuver plan, movement beyond the replan distance threshold, or
+             * exceeding the trajectory reuse timeout all trigger replanning
+             * \return if trajectory should be replanned at current_time
+             */
+            bool isReplanNeeded(ros::Time current_time = ros::Time::now()) const;
+
+            /**
+             * \brief Generate the key identifying a maneuver in the trajectory segment cache
+             * \return a string composed of the maneuver's type, id, planner and start/end conditions
+             */
+            std::string getManeuverCacheKey(const cav_msgs::Maneuver& maneuver) const;
+
+            /**
+             * \brief Look up a previously planned segment for a maneuver. Points before current_time are trimmed
+             * from the cached segment, and it is only reused if the state it starts from matches start_state
+             * within the speculation tolerances
+             * \return if a usable segment was found, in which case it is copied into points
+             */
+            bool findCachedSegment(const std::string& key, const cav_msgs::VehicleState& start_state, ros::Time current_time,
+                                    std::vector<cav_msgs::TrajectoryPlanPoint>& points);
+
+            /**
+             * \brief Stitch a segment planned from planned_start onto a trajectory actually ending at actual_start.
+             * Points up to boundary_time, a target time in nanoseconds, are dropped and the remaining ones are shifted by the start mismatch,
+             * fading the correction out over BOUNDARY_SMOOTHING_DURATION
+             * \return if the mismatch is within the boundary mismatch tolerance and the stitched segment is valid
+             */
+            bool stitchTrajectorySegment(const cav_msgs::VehicleState& planned_start, const cav_msgs::VehicleState& actual_start,
+                                            uint64_t boundary_time, std::vector<cav_msgs::TrajectoryPlanPoint>& points) const;
+
+            /**
+             * \brief Record the inputs of a planning cycle which published a valid trajectory, so following cycles
+             * can skip replanning until they change. A maneuver plan received after planning_plan still triggers replanning
+             */
+            void recordPlanningCycle(ros::Time planning_time, const geometry_msgs::PoseStamped& planning_pose,
+                                        const cav_msgs::ManeuverPlanConstPtr& planning_plan);
+
         protected:
             
             // ROS params
             std::string planning_topic_prefix_;
             std::string planning_topic_suffix_;
             double spin_rate_, max_trajectory_duration_;
+            double replan_distance_threshold_, trajectory_reuse_timeout_;
+            bool speculative_planning_enabled_, trajectory_cache_enabled_, parallel_planning_enabled_;
+            double speculation_position_tolerance_, speculation_speed_tolerance_, boundary_mismatch_tolerance_;
 
             // map to store service clients
             std::unordered_map<std::string, ros::ServiceClient> trajectory_planners_;
             // local storage of incoming messages
-            cav_msgs::ManeuverPlan latest_maneuver_plan_;
+            cav_msgs::ManeuverPlanConstPtr latest_maneuver_plan_;
             geometry_msgs::PoseStamped latest_pose_;
             geometry_msgs::TwistStamped latest_twist_;
 
+            // inputs of the last planning cycle, used to skip replanning when nothing has changed
+            bool maneuver_plan_updated_;
+            geometry_msgs::PoseStamped last_planned_pose_;
+            ros::Time last_planning_time_;
+
+            // trajectory segments of active maneuvers which can be reused in following planning cycles
+            std::unordered_map<std::string, TrajectorySegment> trajectory_cache_;
+
+            /**
+             * \brief Plan trajectory based on latest maneuver plan via ROS service call to plugins
+             * \return a TrajectoryPlan object which contains PlanTrajectory response from plugins
+             */
+            cav_msgs::TrajectoryPlan planTrajectory();
+
+            /**
+             * \brief Call a trajectory planner plugin. Speculative requests call this from worker threads
+             * \return if the service call succeeded
+             */
+            virtual bool callTrajectoryPlanner(ros::ServiceClient& client, cav_srvs::PlanTrajectory& req);
+
         private:
 
             // nodehandle and private nodehandle
@@ -111,6 +230,9 @@ namespace plan_delegator
             ros::Subscriber plan_sub_;
             ros::Subscriber pose_sub_;
             ros::Subscriber twist_sub_;
+            ros::Timer spin_timer_;
+            // only used to report exceptions from the spin timer, which must not escape into a shared nodelet manager
+            std::unique_ptr<ros::CARMANodeHandle> alert_nh_;
 
             /**
              * \brief Callback function of node spin
@@ -118,6 +240,12 @@ namespace plan_delegator
              */
             bool spinCallback();
 
+            /**
+             * \brief Report an exception thrown by the spin timer callback as a FATAL system alert and stop planning
+             * \param what Description of the exception
+             */
+            void handleSpinException(const std::string& what);
+
             /**
              * \brief Example if a maneuver plan contains at least one maneuver
              * \return if input maneuver plan is valid
@@ -136,12 +264,6 @@ namespace plan_delegator
              */
             bool isTrajectoryLongEnough(const cav_msgs::TrajectoryPlan& plan) const noexcept;
 
-            /**
-             * \brief Plan trajectory based on latest maneuver plan via ROS service call to plugins
-             * \return a TrajectoryPlan object which contains PlanTrajectory response from plugins
-             */
-            cav_msgs::TrajectoryPlan planTrajectory();
-
     };
 }
 #endif // PLAN_DELEGATOR_INCLUDE_PLAN_DELEGATOR_HPP_
\ No newline at end of file
@@ -15,22 +15,47 @@
  */
 
 #include <stdexcept>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <utility>
+#include <boost/make_shared.hpp>
+#include <cav_msgs/SystemAlert.h>
 #include "plan_delegator.hpp"
 
 namespace plan_delegator
 {
     PlanDelegator::PlanDelegator() : 
-        planning_topic_prefix_(""), planning_topic_suffix_(""), spin_rate_(10.0), max_trajectory_duration_(6.0) { }
+        planning_topic_prefix_(""), planning_topic_suffix_(""), spin_rate_(10.0), max_trajectory_duration_(6.0),
+        replan_distance_threshold_(0.0), trajectory_reuse_timeout_(0.0), speculative_planning_enabled_(false), trajectory_cache_enabled_(false), parallel_planning_enabled_(false),
+        speculation_position_tolerance_(1.0), speculation_speed_tolerance_(0.5), boundary_mismatch_tolerance_(0.5), maneuver_plan_updated_(false) { }
     
     void PlanDelegator::init()
     {
-        nh_ = ros::CARMANodeHandle();
-        pnh_ = ros::CARMANodeHandle("~");
+        init(ros::CARMANodeHandle(), ros::CARMANodeHandle("~"));
+
+        ros::CARMANodeHandle::setSpinCallback(std::bind(&PlanDelegator::spinCallback, this));
+        ros::CARMANodeHandle::setSpinRate(spin_rate_);
+    }
+
+    void PlanDelegator::init(ros::NodeHandle nh, ros::NodeHandle pnh)
+    {
+        nh_ = nh;
+        pnh_ = pnh;
 
         pnh_.param<std::string>("planning_topic_prefix", planning_topic_prefix_, "/plugins/");        
         pnh_.param<std::string>("planning_topic_suffix", planning_topic_suffix_, "/plan_trajectory");
         pnh_.param<double>("spin_rate", spin_rate_, 10.0);
         pnh_.param<double>("trajectory_duration_threshold", max_trajectory_duration_, 6.0);
+        pnh_.param<double>("replan_distance_threshold", replan_distance_threshold_, 0.0);
+        pnh_.param<double>("trajectory_reuse_timeout", trajectory_reuse_timeout_, 0.0);
+        pnh_.param<bool>("enable_speculative_planning", speculative_planning_enabled_, false);
+        pnh_.param<bool>("enable_trajectory_cache", trajectory_cache_enabled_, false);
+        pnh_.param<bool>("enable_parallel_planning", parallel_planning_enabled_, false);
+        pnh_.param<double>("boundary_mismatch_tolerance", boundary_mismatch_tolerance_, 0.5);
+        pnh_.param<double>("speculation_position_tolerance", speculation_position_tolerance_, 1.0);
+        pnh_.param<double>("speculation_speed_tolerance", speculation_speed_tolerance_, 0.5);
 
         traj_pub_ = nh_.advertise<cav_msgs::TrajectoryPlan>("plan_trajectory", 5);
         plan_sub_ = nh_.subscribe("final_maneuver_plan", 5, &PlanDelegator::maneuverPlanCallback, this);
@@ -38,9 +63,39 @@ namespace plan_delegator
             [&](const geometry_msgs::TwistStampedConstPtr& twist) {latest_twist_ = *twist;});
         pose_sub_ = nh_.subscribe<geometry_msgs::PoseStamped>("current_pose", 5,
             [&](const geometry_msgs::PoseStampedConstPtr& pose) {latest_pose_ = *pose;});
+    }
 
-        ros::CARMANodeHandle::setSpinCallback(std::bind(&PlanDelegator::spinCallback, this));
-        ros::CARMANodeHandle::setSpinRate(spin_rate_);
+    void PlanDelegator::startSpinTimer()
+    {
+        alert_nh_.reset(new ros::CARMANodeHandle(nh_.getNamespace()));
+        spin_timer_ = nh_.createTimer(ros::Duration(1.0 / spin_rate_), [this](const ros::TimerEvent&)
+        {
+            // a plain node handle does not catch callback exceptions the way CARMANodeHandle::spin does
+            try
+            {
+                spinCallback();
+            }
+            catch(const std::exception& e)
+            {
+                handleSpinException(e.what());
+            }
+            catch(...)
+            {
+                // GET_MANEUVER_PROPERTY throws by pointer
+                handleSpinException("unknown exception");
+            }
+        });
+    }
+
+    void PlanDelegator::handleSpinException(const std::string& what)
+    {
+        cav_msgs::SystemAlert alert;
+        alert.type = cav_msgs::SystemAlert::FATAL;
+        alert.description = "Uncaught Exception in " + ros::this_node::getName() + " exception: " + what;
+        ROS_ERROR_STREAM(alert.description);
+        alert_nh_->publishSystemAlert(alert);
+        // stop planning like the node would, the other nodelets in the manager keep running
+        spin_timer_.stop();
     }
     
     void PlanDelegator::run() 
@@ -54,7 +109,8 @@ namespace plan_delegator
         // do basic check to see if the input is valid
         if (isManeuverPlanValid(plan))
         {
-            latest_maneuver_plan_ = *plan;
+            latest_maneuver_plan_ = plan;
+            maneuver_plan_updated_ = true;
         }
         else {
             ROS_WARN_STREAM("Received empty plan, no maneuvers found in plan ID " << plan->maneuver_plan_id);
@@ -96,85 +152,386 @@ namespace plan_delegator
     cav_srvs::PlanTrajectory PlanDelegator::composePlanTrajectoryRequest(const cav_msgs::TrajectoryPlan& latest_trajectory_plan) const
     {
         auto plan_req = cav_srvs::PlanTrajectory{};
-        plan_req.request.maneuver_plan = latest_maneuver_plan_;
+        if(latest_maneuver_plan_)
+        {
+            plan_req.request.maneuver_plan = *latest_maneuver_plan_;
+        }
+        plan_req.request.vehicle_state = composeVehicleState(latest_trajectory_plan);
+        return plan_req;
+    }
+
+    cav_msgs::VehicleState PlanDelegator::composeVehicleState(const cav_msgs::TrajectoryPlan& latest_trajectory_plan) const
+    {
+        cav_msgs::VehicleState vehicle_state;
         // set current vehicle state if we have NOT planned any previous trajectories
         if(latest_trajectory_plan.trajectory_points.empty())
         {
-            plan_req.request.vehicle_state.longitudinal_vel = latest_twist_.twist.linear.x;
-            plan_req.request.vehicle_state.X_pos_global = latest_pose_.pose.position.x;
-            plan_req.request.vehicle_state.Y_pos_global = latest_pose_.pose.position.y;
+            vehicle_state.longitudinal_vel = latest_twist_.twist.linear.x;
+            vehicle_state.X_pos_global = latest_pose_.pose.position.x;
+            vehicle_state.Y_pos_global = latest_pose_.pose.position.y;
         }
         // set vehicle state based on last two planned trajectory points
         else
         {
-            cav_msgs::TrajectoryPlanPoint last_point = latest_trajectory_plan.trajectory_points.back();
-            cav_msgs::TrajectoryPlanPoint second_last_point = *(latest_trajectory_plan.trajectory_points.rbegin() + 1);
-            plan_req.request.vehicle_state.X_pos_global = last_point.x;
-            plan_req.request.vehicle_state.Y_pos_global = last_point.y;
+            const cav_msgs::TrajectoryPlanPoint& last_point = latest_trajectory_plan.trajectory_points.back();
+            const cav_msgs::TrajectoryPlanPoint& second_last_point = *(latest_trajectory_plan.trajectory_points.rbegin() + 1);
+            vehicle_state.X_pos_global = last_point.x;
+            vehicle_state.Y_pos_global = last_point.y;
             auto distance_diff = std::sqrt(std::pow(last_point.x - second_last_point.x, 2) + std::pow(last_point.y - second_last_point.y, 2));
-            auto time_diff = (last_point.target_time - second_last_point.target_time) * MILLISECOND_TO_SECOND;
+            auto time_diff = (last_point.target_time - second_last_point.target_time) * NANOSECOND_TO_SECOND;
             // this assumes the vehicle does not have significant lateral velocity
-            plan_req.request.vehicle_state.longitudinal_vel = distance_diff / time_diff;
+            vehicle_state.longitudinal_vel = distance_diff / time_diff;
         }
-        return plan_req;
+        return vehicle_state;
+    }
+
+    void PlanDelegator::appendTrajectoryPoints(cav_msgs::TrajectoryPlan& latest_trajectory_plan, std::vector<cav_msgs::TrajectoryPlanPoint>&& points) const
+    {
+        auto& trajectory_points = latest_trajectory_plan.trajectory_points;
+        if(trajectory_points.empty())
+        {
+            trajectory_points = std::move(points);
+            // reserve room for the rest of the horizon assuming following segments have a similar point density
+            double segment_duration = (trajectory_points.back().target_time - trajectory_points.front().target_time) * NANOSECOND_TO_SECOND;
+            if(segment_duration > 0.0 && segment_duration < max_trajectory_duration_)
+            {
+                trajectory_points.reserve(static_cast<size_t>(std::ceil(trajectory_points.size() * max_trajectory_duration_ / segment_duration)) + 1);
+            }
+            return;
+        }
+        trajectory_points.reserve(trajectory_points.size() + points.size());
+        trajectory_points.insert(trajectory_points.end(), std::make_move_iterator(points.begin()), std::make_move_iterator(points.end()));
+        points.clear();
     }
 
     bool PlanDelegator::isTrajectoryLongEnough(const cav_msgs::TrajectoryPlan& plan) const noexcept
     {
-        return (plan.trajectory_points.back().target_time - plan.trajectory_points.front().target_time) * MILLISECOND_TO_SECOND >= max_trajectory_duration_;
+        return (plan.trajectory_points.back().target_time - plan.trajectory_points.front().target_time) * NANOSECOND_TO_SECOND >= max_trajectory_duration_;
+    }
+
+    cav_msgs::VehicleState PlanDelegator::estimateManeuverStartState(const cav_msgs::Maneuver& maneuver, ros::Time current_time) const
+    {
+        cav_msgs::VehicleState state;
+        state.longitudinal_vel = GET_MANEUVER_PROPERTY(maneuver, start_speed);
+        // estimate current downtrack distance by interpolating within the maneuver being executed right now
+        double current_dist = GET_MANEUVER_PROPERTY(maneuver, start_dist);
+        for(const auto& active : latest_maneuver_plan_->maneuvers)
+        {
+            if(isManeuverExpired(active, current_time))
+            {
+                continue;
+            }
+            ros::Time start_time = GET_MANEUVER_PROPERTY(active, start_time);
+            ros::Time end_time = GET_MANEUVER_PROPERTY(active, end_time);
+            double progress = std::max(0.0, std::min(1.0, (current_time - start_time).toSec() / (end_time - start_time).toSec()));
+            current_dist = GET_MANEUVER_PROPERTY(active, start_dist) +
+                            progress * (GET_MANEUVER_PROPERTY(active, end_dist) - GET_MANEUVER_PROPERTY(active, start_dist));
+            break;
+        }
+        double remaining_dist = std::max(0.0, GET_MANEUVER_PROPERTY(maneuver, start_dist) - current_dist);
+        // project along current heading, this assumes the path ahead is close to straight
+        const auto& q = latest_pose_.pose.orientation;
+        double yaw = std::atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (q.y * q.y + q.z * q.z));
+        state.X_pos_global = latest_pose_.pose.position.x + remaining_dist * std::cos(yaw);
+        state.Y_pos_global = latest_pose_.pose.position.y + remaining_dist * std::sin(yaw);
+        return state;
+    }
+
+    bool PlanDelegator::isSpeculativeStateConsistent(const cav_msgs::VehicleState& estimated, const cav_msgs::VehicleState& actual) const noexcept
+    {
+        auto position_diff = std::sqrt(std::pow(estimated.X_pos_global - actual.X_pos_global, 2) + std::pow(estimated.Y_pos_global - actual.Y_pos_global, 2));
+        return position_diff <= speculation_position_tolerance_ &&
+                std::fabs(estimated.longitudinal_vel - actual.longitudinal_vel) <= speculation_speed_tolerance_;
+    }
+
+    bool PlanDelegator::isReplanNeeded(ros::Time current_time) const
+    {
+        if(maneuver_plan_updated_ || last_planning_time_.isZero())
+        {
+            return true;
+        }
+        if((current_time - last_planning_time_).toSec() >= trajectory_reuse_timeout_)
+        {
+            return true;
+        }
+        auto distance_moved = std::sqrt(std::pow(latest_pose_.pose.position.x - last_planned_pose_.pose.position.x, 2) +
+                                        std::pow(latest_pose_.pose.position.y - last_planned_pose_.pose.position.y, 2));
+        return distance_moved > replan_distance_threshold_;
+    }
+
+    std::string PlanDelegator::getManeuverCacheKey(const cav_msgs::Maneuver& maneuver) const
+    {
+        std::ostringstream key;
+        // distances and speeds are written at full precision so maneuvers far downtrack still get distinct keys
+        key << std::setprecision(17) << static_cast<int>(maneuver.type) << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, parameters.maneuver_id) << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, parameters.planning_strategic_plugin) << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, start_time).toNSec() << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, end_time).toNSec() << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, start_dist) << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, end_dist) << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, start_speed) << ":"
+            << GET_MANEUVER_PROPERTY(maneuver, end_speed);
+        return key.str();
+    }
+
+    bool PlanDelegator::findCachedSegment(const std::string& key, const cav_msgs::VehicleState& start_state, ros::Time current_time,
+                                            std::vector<cav_msgs::TrajectoryPlanPoint>& points)
+    {
+        auto cached = trajectory_cache_.find(key);
+        if(cached == trajectory_cache_.end())
+        {
+            return false;
+        }
+        TrajectorySegment& segment = cached->second;
+        // points are ordered by target time, so everything before the first unexpired point can be dropped
+        uint64_t current_time_ns = current_time.toNSec();
+        auto first_valid = std::lower_bound(segment.points.begin(), segment.points.end(), current_time_ns,
+            [](const cav_msgs::TrajectoryPlanPoint& point, uint64_t time) { return point.target_time < time; });
+        if(first_valid == segment.points.end() || segment.points.end() - first_valid < 2)
+        {
+            trajectory_cache_.erase(cached);
+            return false;
+        }
+        if(first_valid != segment.points.begin())
+        {
+            // the segment is already being driven, so compare against where it expects the vehicle to be now
+            const cav_msgs::TrajectoryPlanPoint& prev_point = *(first_valid - 1);
+            const cav_msgs::TrajectoryPlanPoint& next_point = *first_valid;
+            double time_diff = (next_point.target_time - prev_point.target_time) * NANOSECOND_TO_SECOND;
+            double ratio = time_diff > 0 ? (current_time_ns - prev_point.target_time) * NANOSECOND_TO_SECOND / time_diff : 0.0;
+            segment.start_state.X_pos_global = prev_point.x + ratio * (next_point.x - prev_point.x);
+            segment.start_state.Y_pos_global = prev_point.y + ratio * (next_point.y - prev_point.y);
+            if(time_diff > 0)
+            {
+                segment.start_state.longitudinal_vel = std::sqrt(std::pow(next_point.x - prev_point.x, 2) + std::pow(next_point.y - prev_point.y, 2)) / time_diff;
+            }
+            segment.points.erase(segment.points.begin(), first_valid);
+        }
+        if(!isSpeculativeStateConsistent(segment.start_state, start_state))
+        {
+            return false;
+        }
+        points = segment.points;
+        return true;
+    }
+
+    bool PlanDelegator::stitchTrajectorySegment(const cav_msgs::VehicleState& planned_start, const cav_msgs::VehicleState& actual_start,
+                                                uint64_t boundary_time, std::vector<cav_msgs::TrajectoryPlanPoint>& points) const
+    {
+        double offset_x = actual_start.X_pos_global - planned_start.X_pos_global;
+        double offset_y = actual_start.Y_pos_global - planned_start.Y_pos_global;
+        if(std::sqrt(offset_x * offset_x + offset_y * offset_y) > boundary_mismatch_tolerance_)
+        {
+            return false;
+        }
+        // drop points overlapping the preceding trajectory
+        auto first_new = std::upper_bound(points.begin(), points.end(), boundary_time,
+            [](uint64_t time, const cav_msgs::TrajectoryPlanPoint& point) { return time < point.target_time; });
+        points.erase(points.begin(), first_new);
+        if(points.size() < 2)
+        {
+            return false;
+        }
+        // shift the start of the segment onto the preceding trajectory, fading the correction out over the smoothing window
+        uint64_t segment_start = boundary_time > 0 ? boundary_time : points.front().target_time;
+        for(auto& point : points)
+        {
+            double weight = 1.0 - (point.target_time - segment_start) * NANOSECOND_TO_SECOND / BOUNDARY_SMOOTHING_DURATION;
+            if(weight <= 0.0)
+            {
+                break;
+            }
+            point.x += weight * offset_x;
+            point.y += weight * offset_y;
+        }
+        return true;
+    }
+
+    void PlanDelegator::recordPlanningCycle(ros::Time planning_time, const geometry_msgs::PoseStamped& planning_pose,
+                                            const cav_msgs::ManeuverPlanConstPtr& planning_plan)
+    {
+        maneuver_plan_updated_ = latest_maneuver_plan_ != planning_plan;
+        last_planned_pose_ = planning_pose;
+        last_planning_time_ = planning_time;
+    }
+
+    bool PlanDelegator::callTrajectoryPlanner(ros::ServiceClient& client, cav_srvs::PlanTrajectory& req)
+    {
+        return client.call(req);
     }
 
     cav_msgs::TrajectoryPlan PlanDelegator::planTrajectory()
     {
         cav_msgs::TrajectoryPlan latest_trajectory_plan;
-        // iterate through maneuver list to make service call
-        for(const auto& maneuver : latest_maneuver_plan_.maneuvers)
+        if(!latest_maneuver_plan_)
         {
-            // ignore expired maneuvers
-            if(isManeuverExpired(maneuver))
+            return latest_trajectory_plan;
+        }
+        ros::Time current_time = ros::Time::now();
+        // collect maneuvers which still need to be planned, ignoring expired ones
+        std::vector<const cav_msgs::Maneuver*> active_maneuvers;
+        for(const auto& maneuver : latest_maneuver_plan_->maneuvers)
+        {
+            if(!isManeuverExpired(maneuver, current_time))
             {
-                continue;
+                active_maneuvers.push_back(&maneuver);
+            }
+        }
+        // requests issued from a maneuver's estimated start state before the preceding trajectory is known
+        std::vector<cav_srvs::PlanTrajectory> speculative_reqs(active_maneuvers.size());
+        std::vector<std::future<bool>> speculative_calls(active_maneuvers.size());
+        auto speculate = [&](size_t idx)
+        {
+            const cav_msgs::Maneuver& maneuver = *active_maneuvers[idx];
+            // only maneuvers within the trajectory horizon which have not been planned before are worth requesting
+            if(GET_MANEUVER_PROPERTY(maneuver, start_time) >= current_time + ros::Duration(max_trajectory_duration_) ||
+                (trajectory_cache_enabled_ && trajectory_cache_.count(getManeuverCacheKey(maneuver))))
+            {
+                return;
+            }
+            // the client is copied into the worker thread, which only duplicates its shared handle
+            ros::ServiceClient client = getPlannerClientByName(GET_MANEUVER_PROPERTY(maneuver, parameters.planning_strategic_plugin));
+            cav_srvs::PlanTrajectory* req = &speculative_reqs[idx];
+            // concurrent requests are serialized independently, so each one holds its own copy of the plan
+            req->request.maneuver_plan = *latest_maneuver_plan_;
+            req->request.vehicle_state = estimateManeuverStartState(maneuver, current_time);
+            speculative_calls[idx] = std::async(std::launch::async, [this, client, req]() mutable {
+                return callTrajectoryPlanner(client, *req);
+            });
+        };
+        if(parallel_planning_enabled_)
+        {
+            // the first maneuver starts from the known vehicle state, every following one is requested up front
+            for(size_t i = 1; i < active_maneuvers.size(); ++i)
+            {
+                speculate(i);
             }
+        }
+        // a single request is reused for every sequential call so the maneuver plan is only copied into it once
+        auto plan_req = composePlanTrajectoryRequest(latest_trajectory_plan);
+        for(size_t i = 0; i < active_maneuvers.size(); ++i)
+        {
+            const cav_msgs::Maneuver& maneuver = *active_maneuvers[i];
             // get corresponding ros service client for plan trajectory
-            auto maneuver_planner = GET_MANEUVER_PROPERTY(maneuver, parameters.planning_strategic_plugin);
-            auto client = getPlannerClientByName(maneuver_planner);
-            // compose service request
-            auto plan_req = composePlanTrajectoryRequest(latest_trajectory_plan);
-            if(client.call(plan_req))
+            const auto& maneuver_planner = GET_MANEUVER_PROPERTY(maneuver, parameters.planning_strategic_plugin);
+            ros::ServiceClient& client = getPlannerClientByName(maneuver_planner);
+            // update service request with the state reached so far
+            plan_req.request.vehicle_state = composeVehicleState(latest_trajectory_plan);
+            plan_req.response = cav_srvs::PlanTrajectoryResponse();
+            auto cache_key = getManeuverCacheKey(maneuver);
+            // reuse the segment planned in an earlier cycle if it still starts from the same state
+            bool cached = trajectory_cache_enabled_ &&
+                findCachedSegment(cache_key, plan_req.request.vehicle_state, current_time, plan_req.response.trajectory_plan.trajectory_points);
+            bool success = cached;
+            bool planned = cached;
+            if(speculative_calls[i].valid())
+            {
+                // reconcile the speculative result with the state actually reached by the previous trajectory
+                cav_srvs::PlanTrajectory& speculative_req = speculative_reqs[i];
+                bool speculative_success = speculative_calls[i].get() && !planned;
+                if(speculative_success && parallel_planning_enabled_)
+                {
+                    uint64_t boundary_time = latest_trajectory_plan.trajectory_points.empty() ? 0 : latest_trajectory_plan.trajectory_points.back().target_time;
+                    speculative_success = stitchTrajectorySegment(speculative_req.request.vehicle_state, plan_req.request.vehicle_state,
+                                                                    boundary_time, speculative_req.response.trajectory_plan.trajectory_points);
+                    // the stitched segment now starts from the actual state
+                    speculative_req.request.vehicle_state = plan_req.request.vehicle_state;
+                }
+                else if(speculative_success)
+                {
+                    speculative_success = isSpeculativeStateConsistent(speculative_req.request.vehicle_state, plan_req.request.vehicle_state);
+                }
+                if(speculative_success)
+                {
+                    plan_req.request.vehicle_state = speculative_req.request.vehicle_state;
+                    plan_req.response = std::move(speculative_req.response);
+                    success = true;
+                    planned = true;
+                }
+                else if(!planned)
+                {
+                    ROS_DEBUG_STREAM("Discarding speculative trajectory for " << maneuver_planner << ", replanning from actual state");
+                }
+            }
+            // pipeline the next maneuver while this one is in flight
+            if(speculative_planning_enabled_ && !parallel_planning_enabled_ && i + 1 < active_maneuvers.size())
+            {
+                speculate(i + 1);
+            }
+            if(!planned)
+            {
+                success = callTrajectoryPlanner(client, plan_req);
+            }
+            if(success)
             {
                 // validate trajectory before add to the plan
                 if(!isTrajectoryValid(plan_req.response.trajectory_plan))
                 {
-                    ROS_WARN_STREAM("Found invalid trajectory with less than 2 trajectory points for " << latest_maneuver_plan_.maneuver_plan_id);
+                    ROS_WARN_STREAM("Found invalid trajectory with less than 2 trajectory points for " << latest_maneuver_plan_->maneuver_plan_id);
                     break;
                 }
-                latest_trajectory_plan.trajectory_points.insert(latest_trajectory_plan.trajectory_points.end(),
-                                                                plan_req.response.trajectory_plan.trajectory_points.begin(),
-                                                                plan_req.response.trajectory_plan.trajectory_points.end());
+                if(trajectory_cache_enabled_ && !cached)
+                {
+                    trajectory_cache_[cache_key] = TrajectorySegment{plan_req.request.vehicle_state, plan_req.response.trajectory_plan.trajectory_points};
+                }
+                appendTrajectoryPoints(latest_trajectory_plan, std::move(plan_req.response.trajectory_plan.trajectory_points));
                 if(isTrajectoryLongEnough(latest_trajectory_plan))
                 {
-                    ROS_INFO_STREAM("Plan Trajectory completed for " << latest_maneuver_plan_.maneuver_plan_id);
+                    ROS_INFO_STREAM("Plan Trajectory completed for " << latest_maneuver_plan_->maneuver_plan_id);
                     break;
                 }
             }
             else
             {
-                ROS_WARN_STREAM("Unsuccessful service call to trajectory planner:" << maneuver_planner << " for plan ID " << latest_maneuver_plan_.maneuver_plan_id);
+                ROS_WARN_STREAM("Unsuccessful service call to trajectory planner:" << maneuver_planner << " for plan ID " << latest_maneuver_plan_->maneuver_plan_id);
                 // if one service call fails, it should end plan immediately because it is there is no point to generate plan with empty space
                 break;
             }
         }
+        // outstanding speculative requests refer to local state and must finish before returning
+        for(auto& call : speculative_calls)
+        {
+            if(call.valid())
+            {
+                call.wait();
+            }
+        }
+        // segments of maneuvers which expired or are no longer part of the plan will not be needed again
+        if(trajectory_cache_enabled_)
+        {
+            std::unordered_set<std::string> active_keys;
+            for(const auto& maneuver : active_maneuvers)
+            {
+                active_keys.insert(getManeuverCacheKey(*maneuver));
+            }
+            for(auto it = trajectory_cache_.begin(); it != trajectory_cache_.end();)
+            {
+                it = active_keys.count(it->first) ? std::next(it) : trajectory_cache_.erase(it);
+            }
+        }
         return latest_trajectory_plan;
     }
 
     bool PlanDelegator::spinCallback()
     {
-        cav_msgs::TrajectoryPlan trajectory_plan = planTrajectory();
+        ros::Time current_time = ros::Time::now();
+        if(!isReplanNeeded(current_time))
+        {
+            ROS_DEBUG_STREAM("Maneuver plan and vehicle pose unchanged, skipping trajectory planning");
+            return true;
+        }
+        // inputs are captured up front but only recorded once a trajectory is published, so failed cycles are retried
+        geometry_msgs::PoseStamped planning_pose = latest_pose_;
+        cav_msgs::ManeuverPlanConstPtr planning_plan = latest_maneuver_plan_;
+        // published by pointer so subscribers in the same process share this allocation instead of a serialized copy
+        cav_msgs::TrajectoryPlanPtr trajectory_plan = boost::make_shared<cav_msgs::TrajectoryPlan>(planTrajectory());
         // Check if planned trajectory is valid before send out
-        if(isTrajectoryValid(trajectory_plan))
+        if(isTrajectoryValid(*trajectory_plan))
         {
-            trajectory_plan.header.stamp = ros::Time::now();
+            trajectory_plan->header.stamp = ros::Time::now();
             traj_pub_.publish(trajectory_plan);
+            recordPlanningCycle(current_time, planning_pose, planning_plan);
         }
         else
         {
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <memory>
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+#include "plan_delegator.hpp"
+
+namespace plan_delegator
+{
+    /**
+     * \brief Nodelet wrapper of the plan delegator. When loaded into the same manager as the trajectory executor
+     * the planned trajectory is handed over by pointer instead of being serialized
+     */
+    class PlanDelegatorNodelet : public nodelet::Nodelet
+    {
+        private:
+            std::unique_ptr<PlanDelegator> pd_;
+
+            void onInit() override
+            {
+                pd_.reset(new PlanDelegator());
+                pd_->init(getNodeHandle(), getPrivateNodeHandle());
+                pd_->startSpinTimer();
+            }
+    };
+}
+
+PLUGINLIB_EXPORT_CLASS(plan_delegator::PlanDelegatorNodelet, nodelet::Nodelet)
@@ -16,6 +16,8 @@
 
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <cmath>
 #include <cav_msgs/ManeuverPlan.h>
 #include <cav_srvs/PlanTrajectory.h>
 #include <gtest/gtest.h>
@@ -59,15 +61,122 @@
 
             cav_msgs::ManeuverPlan getLatestManeuverPlan()
             {
-                return this->latest_maneuver_plan_;
+                return *this->latest_maneuver_plan_;
             }
 
             std::unordered_map<std::string, ros::ServiceClient> getServiceMap()
             {
                 return this->trajectory_planners_;
             }
+
+            void setLatestPose(double x, double y)
+            {
+                this->latest_pose_.pose.position.x = x;
+                this->latest_pose_.pose.position.y = y;
+            }
+
+            void setReplanThresholds(double distance, double timeout)
+            {
+                this->replan_distance_threshold_ = distance;
+                this->trajectory_reuse_timeout_ = timeout;
+            }
+
+            void cacheSegment(const std::string& key, const plan_delegator::TrajectorySegment& segment)
+            {
+                this->trajectory_cache_[key] = segment;
+            }
+
+            size_t getCacheSize()
+            {
+                return this->trajectory_cache_.size();
+            }
+
+            void markPlanned(ros::Time time)
+            {
+                markPlanned(time, this->latest_maneuver_plan_);
+            }
+
+            void markPlanned(ros::Time time, const cav_msgs::ManeuverPlanConstPtr& plan)
+            {
+                this->recordPlanningCycle(time, this->latest_pose_, plan);
+            }
+
+            void setLatestTwist(double speed)
+            {
+                this->latest_twist_.twist.linear.x = speed;
+            }
+
+            void setPlanningModes(bool speculative, bool cache, bool parallel)
+            {
+                this->speculative_planning_enabled_ = speculative;
+                this->trajectory_cache_enabled_ = cache;
+                this->parallel_planning_enabled_ = parallel;
+            }
+
+            int getPlannerCalls()
+            {
+                return this->planner_calls_;
+            }
+
+            using plan_delegator::PlanDelegator::planTrajectory;
+
+        protected:
+
+            // Stub planner plugin driving the maneuver starting closest to the requested state at the requested speed,
+            // with a point every 0.5s and nanosecond target times like the real plugins
+            bool callTrajectoryPlanner(ros::ServiceClient& client, cav_srvs::PlanTrajectory& req) override
+            {
+                ++this->planner_calls_;
+                const cav_msgs::VehicleState& state = req.request.vehicle_state;
+                const cav_msgs::Maneuver* maneuver = nullptr;
+                for(const auto& candidate : req.request.maneuver_plan.maneuvers)
+                {
+                    if(!maneuver || std::fabs(GET_MANEUVER_PROPERTY(candidate, start_dist) - state.X_pos_global) <
+                                    std::fabs(GET_MANEUVER_PROPERTY(*maneuver, start_dist) - state.X_pos_global))
+                    {
+                        maneuver = &candidate;
+                    }
+                }
+                ros::Time start_time = GET_MANEUVER_PROPERTY(*maneuver, start_time);
+                ros::Time end_time = GET_MANEUVER_PROPERTY(*maneuver, end_time);
+                for(ros::Time t = start_time; t <= end_time; t += ros::Duration(0.5))
+                {
+                    cav_msgs::TrajectoryPlanPoint point;
+                    point.x = state.X_pos_global + state.longitudinal_vel * (t - start_time).toSec();
+                    point.y = state.Y_pos_global;
+                    point.target_time = t.toNSec();
+                    req.response.trajectory_plan.trajectory_points.push_back(point);
+                }
+                return true;
+            }
+
+        private:
+
+            std::atomic<int> planner_calls_{0};
     };
 
+    /**
+     * \brief Plan of two consecutive 4s maneuvers at 10 m/s starting at start_time, which only cover the 6s horizon together
+     */
+    cav_msgs::ManeuverPlanConstPtr makeTwoManeuverPlan(ros::Time start_time)
+    {
+        cav_msgs::ManeuverPlan plan;
+        for(int i = 0; i < 2; ++i)
+        {
+            cav_msgs::Maneuver maneuver;
+            maneuver.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+            maneuver.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_A";
+            maneuver.lane_following_maneuver.start_time = start_time + ros::Duration(4.0 * i);
+            maneuver.lane_following_maneuver.end_time = start_time + ros::Duration(4.0 * (i + 1));
+            maneuver.lane_following_maneuver.start_dist = 40.0 * i;
+            maneuver.lane_following_maneuver.end_dist = 40.0 * (i + 1);
+            maneuver.lane_following_maneuver.start_speed = 10.0;
+            maneuver.lane_following_maneuver.end_speed = 10.0;
+            plan.maneuvers.push_back(maneuver);
+        }
+        return cav_msgs::ManeuverPlanConstPtr(new cav_msgs::ManeuverPlan(plan));
+    }
+
     TEST(TestPlanDelegator, UnitTestPlanDelegator) {
         PlanDelegatorTest pd;
         // test initialization
@@ -113,7 +222,7 @@
         cav_msgs::TrajectoryPlanPoint point_2;
         point_2.x = 1.0;
         point_2.y = 1.0;
-        point_2.target_time = 1.41421 / PlanDelegatorTest::MILLISECOND_TO_SECOND;
+        point_2.target_time = ros::Duration(1.41421).toNSec();
         traj_plan.trajectory_points.push_back(point_1);
         traj_plan.trajectory_points.push_back(point_2);
         cav_srvs::PlanTrajectory req = pd.composePlanTrajectoryRequest(traj_plan);
@@ -122,6 +231,181 @@
         EXPECT_NEAR(1.0, req.request.vehicle_state.longitudinal_vel, 0.1);
     }
 
+    TEST(TestPlanDelegator, TestReplanAndSpeculation) {
+        PlanDelegatorTest pd;
+        ros::Time plan_time(100, 0);
+        // nothing has been planned yet
+        EXPECT_EQ(true, pd.isReplanNeeded(plan_time));
+        pd.setReplanThresholds(0.1, 1.0);
+        pd.markPlanned(plan_time);
+        EXPECT_EQ(false, pd.isReplanNeeded(plan_time + ros::Duration(0.5)));
+        EXPECT_EQ(true, pd.isReplanNeeded(plan_time + ros::Duration(1.5)));
+        pd.setLatestPose(1.0, 0.0);
+        EXPECT_EQ(true, pd.isReplanNeeded(plan_time + ros::Duration(0.5)));
+        pd.markPlanned(plan_time);
+        // a new maneuver plan always triggers replanning
+        cav_msgs::ManeuverPlan plan;
+        cav_msgs::Maneuver current, next;
+        current.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        current.lane_following_maneuver.start_time = ros::Time(100, 0);
+        current.lane_following_maneuver.end_time = ros::Time(110, 0);
+        current.lane_following_maneuver.start_dist = 0.0;
+        current.lane_following_maneuver.end_dist = 100.0;
+        next.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        next.lane_following_maneuver.start_time = ros::Time(110, 0);
+        next.lane_following_maneuver.end_time = ros::Time(115, 0);
+        next.lane_following_maneuver.start_dist = 100.0;
+        next.lane_following_maneuver.start_speed = 12.0;
+        plan.maneuvers.push_back(current);
+        plan.maneuvers.push_back(next);
+        cav_msgs::ManeuverPlanConstPtr planning_plan(new cav_msgs::ManeuverPlan(plan));
+        pd.maneuverPlanCallback(planning_plan);
+        EXPECT_EQ(true, pd.isReplanNeeded(plan_time + ros::Duration(0.5)));
+        // a plan received while planning from the previous one still needs its own trajectory
+        pd.maneuverPlanCallback(cav_msgs::ManeuverPlanConstPtr(new cav_msgs::ManeuverPlan(plan)));
+        pd.markPlanned(plan_time, planning_plan);
+        EXPECT_EQ(true, pd.isReplanNeeded(plan_time + ros::Duration(0.5)));
+        pd.markPlanned(plan_time);
+        EXPECT_EQ(false, pd.isReplanNeeded(plan_time + ros::Duration(0.5)));
+        // halfway through the current maneuver the next one starts 50m ahead along the current heading
+        cav_msgs::VehicleState estimate = pd.estimateManeuverStartState(next, ros::Time(105, 0));
+        EXPECT_NEAR(51.0, estimate.X_pos_global, 0.01);
+        EXPECT_NEAR(0.0, estimate.Y_pos_global, 0.01);
+        EXPECT_NEAR(12.0, estimate.longitudinal_vel, 0.01);
+        cav_msgs::VehicleState actual = estimate;
+        actual.X_pos_global += 0.5;
+        EXPECT_EQ(true, pd.isSpeculativeStateConsistent(estimate, actual));
+        actual.longitudinal_vel += 1.0;
+        EXPECT_EQ(false, pd.isSpeculativeStateConsistent(estimate, actual));
+    }
+
+    TEST(TestPlanDelegator, TestTrajectoryCache) {
+        PlanDelegatorTest pd;
+        cav_msgs::Maneuver maneuver;
+        maneuver.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        maneuver.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_A";
+        maneuver.lane_following_maneuver.end_time = ros::Time(110, 0);
+        std::string key = pd.getManeuverCacheKey(maneuver);
+        cav_msgs::Maneuver other_maneuver = maneuver;
+        other_maneuver.lane_following_maneuver.end_time = ros::Time(111, 0);
+        EXPECT_NE(key, pd.getManeuverCacheKey(other_maneuver));
+        // maneuvers 10cm apart more than a kilometer downtrack
+        cav_msgs::Maneuver downtrack_maneuver = maneuver;
+        downtrack_maneuver.lane_following_maneuver.start_dist = 1234.5;
+        cav_msgs::Maneuver next_downtrack_maneuver = maneuver;
+        next_downtrack_maneuver.lane_following_maneuver.start_dist = 1234.6;
+        EXPECT_NE(pd.getManeuverCacheKey(downtrack_maneuver), pd.getManeuverCacheKey(next_downtrack_maneuver));
+        // segment driving along x at 10 m/s, one point per second starting at t = 100s
+        plan_delegator::TrajectorySegment segment;
+        segment.start_state.longitudinal_vel = 10.0;
+        for(int i = 0; i < 5; ++i)
+        {
+            cav_msgs::TrajectoryPlanPoint point;
+            point.x = 10.0 * i;
+            point.target_time = ros::Time(100 + i, 0).toNSec();
+            segment.points.push_back(point);
+        }
+        pd.cacheSegment(key, segment);
+        std::vector<cav_msgs::TrajectoryPlanPoint> points;
+        cav_msgs::VehicleState state;
+        state.longitudinal_vel = 10.0;
+        EXPECT_EQ(false, pd.findCachedSegment(pd.getManeuverCacheKey(other_maneuver), state, ros::Time(100, 0), points));
+        EXPECT_EQ(true, pd.findCachedSegment(key, state, ros::Time(100, 0), points));
+        EXPECT_EQ(5, points.size());
+        // expired points are trimmed and the vehicle must be near where the segment expects it to be
+        state.X_pos_global = 15.0;
+        EXPECT_EQ(true, pd.findCachedSegment(key, state, ros::Time(101, 500000000), points));
+        EXPECT_EQ(3, points.size());
+        EXPECT_EQ(ros::Time(102, 0).toNSec(), points.front().target_time);
+        state.X_pos_global = 20.0;
+        EXPECT_EQ(false, pd.findCachedSegment(key, state, ros::Time(101, 500000000), points));
+        // segments with fewer than two remaining points are evicted
+        EXPECT_EQ(false, pd.findCachedSegment(key, state, ros::Time(103, 500000000), points));
+        EXPECT_EQ(0, pd.getCacheSize());
+    }
+
+    TEST(TestPlanDelegator, TestCachedSegmentsAreReused) {
+        PlanDelegatorTest pd;
+        pd.setPlanningModes(false, true, false);
+        pd.setLatestTwist(10.0);
+        ros::Time start_time = ros::Time::now();
+        pd.maneuverPlanCallback(makeTwoManeuverPlan(start_time));
+        // without stitching the second segment repeats the boundary point
+        EXPECT_EQ(18, pd.planTrajectory().trajectory_points.size());
+        EXPECT_EQ(2, pd.getPlannerCalls());
+        EXPECT_EQ(2, pd.getCacheSize());
+        // the vehicle and the end of the first segment are where both cached segments expect them, so neither is requested again
+        cav_msgs::TrajectoryPlan traj_plan = pd.planTrajectory();
+        EXPECT_EQ(2, pd.getPlannerCalls());
+        EXPECT_NEAR(80.0, traj_plan.trajectory_points.back().x, 0.01);
+        EXPECT_EQ((start_time + ros::Duration(8.0)).toNSec(), traj_plan.trajectory_points.back().target_time);
+    }
+
+    TEST(TestPlanDelegator, TestBoundaryStitching) {
+        PlanDelegatorTest pd;
+        cav_msgs::VehicleState planned_start, actual_start;
+        planned_start.X_pos_global = 10.0;
+        actual_start.X_pos_global = 10.4;
+        // segment planned from x = 10m at 10 m/s with a point every 0.5s from t = 1s, its first point overlaps the preceding trajectory
+        uint64_t boundary_time = ros::Time(1, 0).toNSec();
+        std::vector<cav_msgs::TrajectoryPlanPoint> points;
+        for(int i = 0; i < 4; ++i)
+        {
+            cav_msgs::TrajectoryPlanPoint point;
+            point.x = 10.0 + 5.0 * i;
+            point.target_time = boundary_time + i * ros::Duration(0.5).toNSec();
+            points.push_back(point);
+        }
+        std::vector<cav_msgs::TrajectoryPlanPoint> stitched = points;
+        EXPECT_EQ(true, pd.stitchTrajectorySegment(planned_start, actual_start, boundary_time, stitched));
+        EXPECT_EQ(3, stitched.size());
+        // the correction fades out over the smoothing window
+        EXPECT_NEAR(15.2, stitched[0].x, 0.001);
+        EXPECT_NEAR(20.0, stitched[1].x, 0.001);
+        EXPECT_NEAR(25.0, stitched[2].x, 0.001);
+        actual_start.X_pos_global = 11.0;
+        stitched = points;
+        EXPECT_EQ(false, pd.stitchTrajectorySegment(planned_start, actual_start, boundary_time, stitched));
+    }
+
+    TEST(TestPlanDelegator, TestParallelPlanningStitchesSegments) {
+        PlanDelegatorTest pd;
+        pd.setPlanningModes(false, false, true);
+        pd.setLatestTwist(10.0);
+        ros::Time start_time = ros::Time::now();
+        pd.maneuverPlanCallback(makeTwoManeuverPlan(start_time));
+        cav_msgs::TrajectoryPlan traj_plan = pd.planTrajectory();
+        // the second maneuver was requested up front and stitched onto the first without a further request
+        EXPECT_EQ(2, pd.getPlannerCalls());
+        ASSERT_EQ(17, traj_plan.trajectory_points.size());
+        EXPECT_NEAR(40.0, traj_plan.trajectory_points[8].x, 0.01);
+        EXPECT_NEAR(80.0, traj_plan.trajectory_points.back().x, 0.01);
+        EXPECT_EQ((start_time + ros::Duration(8.0)).toNSec(), traj_plan.trajectory_points.back().target_time);
+        for(size_t i = 1; i < traj_plan.trajectory_points.size(); ++i)
+        {
+            EXPECT_LT(traj_plan.trajectory_points[i - 1].target_time, traj_plan.trajectory_points[i].target_time);
+        }
+    }
+
+    TEST(TestPlanDelegator, TestAppendTrajectoryPoints) {
+        PlanDelegatorTest pd;
+        std::vector<cav_msgs::TrajectoryPlanPoint> segment(11);
+        for(size_t i = 0; i < segment.size(); ++i)
+        {
+            segment[i].target_time = i * ros::Duration(0.2).toNSec();
+        }
+        cav_msgs::TrajectoryPlan traj_plan;
+        pd.appendTrajectoryPoints(traj_plan, std::move(segment));
+        EXPECT_EQ(11, traj_plan.trajectory_points.size());
+        // 11 points over 2 seconds, so the 6 second horizon needs room for 33
+        EXPECT_LE(34, traj_plan.trajectory_points.capacity());
+        std::vector<cav_msgs::TrajectoryPlanPoint> next_segment(10);
+        next_segment.back().target_time = ros::Time(4, 0).toNSec();
+        pd.appendTrajectoryPoints(traj_plan, std::move(next_segment));
+        EXPECT_EQ(21, traj_plan.trajectory_points.size());
+        EXPECT_EQ(ros::Time(4, 0).toNSec(), traj_plan.trajectory_points.back().target_time);
+    }
+
     TEST(TestPlanDelegator, TestPlanDelegator) {
         ros::NodeHandle nh = ros::NodeHandle();
         cav_msgs::TrajectoryPlan res_plan;
@@ -61,8 +61,8 @@ void PurePursuitWrapper::TrajectoryPlanPoseHandler(const geometry_msgs::PoseStam
       double current_time = ros::Time::now().toSec();
       for(int i = 0; i < tp->trajectory_points.size() - 1; i++ ) {
 
-        cav_msgs::TrajectoryPlanPoint t1 = tp->trajectory_points[i];
-        cav_msgs::TrajectoryPlanPoint t2 = tp->trajectory_points[i + 1];
+        const cav_msgs::TrajectoryPlanPoint& t1 = tp->trajectory_points[i];
+        const cav_msgs::TrajectoryPlanPoint& t2 = tp->trajectory_points[i + 1];
         autoware_msgs::Waypoint waypoint = ppww.TrajectoryPlanPointToWaypointConverter(current_time, *pose,t1, t2);
         waypoints.push_back(waypoint);
       }
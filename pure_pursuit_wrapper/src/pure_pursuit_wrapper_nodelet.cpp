@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "pure_pursuit_wrapper/pure_pursuit_wrapper.hpp"
+
+#include <memory>
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+namespace pure_pursuit_wrapper {
+
+/*!
+ * Nodelet for the wrapper. When loaded into the same manager as the trajectory executor
+ * the trajectory plan is received by pointer instead of being deserialized.
+ */
+class PurePursuitWrapperNodelet : public nodelet::Nodelet {
+  private:
+    // The wrapper keeps a reference to the node handle so it must outlive it
+    ros::NodeHandle nh_;
+    std::unique_ptr<PurePursuitWrapper> wrapper_;
+    std::unique_ptr<message_filters::Synchronizer<PurePursuitWrapper::SyncPolicy>> sync_;
+
+    void onInit() override {
+      nh_ = getNodeHandle();
+      wrapper_.reset(new PurePursuitWrapper(nh_));
+
+      // Approximate time of 100ms used because NDT outputs at 10Hz
+      sync_.reset(new message_filters::Synchronizer<PurePursuitWrapper::SyncPolicy>(PurePursuitWrapper::SyncPolicy(100), wrapper_->pose_sub, wrapper_->trajectory_plan_sub));
+      sync_->registerCallback(boost::bind(&PurePursuitWrapper::TrajectoryPlanPoseHandler, wrapper_.get(), _1, _2));
+    }
+};
+
+}  // namespace pure_pursuit_wrapper
+
+PLUGINLIB_EXPORT_CLASS(pure_pursuit_wrapper::PurePursuitWrapperNodelet, nodelet::Nodelet)
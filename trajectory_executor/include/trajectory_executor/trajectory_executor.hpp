@@ -21,13 +21,16 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <vector>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
 #include <cav_msgs/TrajectoryPlan.h>
 #include <cav_msgs/GuidanceState.h>
 #include <ros/subscriber.h>
 #include <ros/publisher.h>
 #include <carma_utils/CARMAUtils.h>
-#include <ros/callback_queue.h>
 
 namespace trajectory_executor {
     /*!
@@ -39,6 +42,70 @@ namespace trajectory_executor {
      */
     cav_msgs::TrajectoryPlan trimPastPoints(const cav_msgs::TrajectoryPlan &plan);
 
+    /*!
+     * \brief Find the first point of a TrajectoryPlan which has a target time
+     * after the specified time. Points are ordered by target_time, so this is
+     * a binary search that does not modify or copy the plan.
+     * 
+     * \param plan The plan to search
+     * \param current_nsec The current time in nanoseconds
+     * \param start_index Index to begin the search at, points before it are already known to be past
+     * \return The index of the first future point, or the number of points if all are past
+     */
+    size_t findFirstFuturePoint(const cav_msgs::TrajectoryPlan &plan, uint64_t current_nsec, size_t start_index = 0);
+
+    /*!
+     * \brief Build a message containing a contiguous window of a TrajectoryPlan's points.
+     * If the window covers the whole plan the plan itself is returned without copying.
+     * 
+     * \param plan The plan to take points from
+     * \param begin Index of the first point in the window
+     * \param end Index one past the last point in the window
+     * \return A message with the contents of plan restricted to [begin, end)
+     */
+    cav_msgs::TrajectoryPlanConstPtr getTrajectoryWindow(const cav_msgs::TrajectoryPlanConstPtr &plan, size_t begin, size_t end);
+
+    /*!
+     * \brief A contiguous range of TrajectoryPlan points [begin, end) assigned to a single control plugin
+     */
+    struct ControllerSegment {
+        size_t begin;
+        size_t end;
+        std::string controller_plugin_name;
+    };
+
+    /*!
+     * \brief Split a TrajectoryPlan into maximal contiguous segments of points sharing
+     * the same controller_plugin_name, in point order.
+     * 
+     * \param plan The plan to split
+     * \return The segments, empty if the plan has no points
+     */
+    std::vector<ControllerSegment> splitByController(const cav_msgs::TrajectoryPlan &plan);
+
+    /*!
+     * \brief Running statistics of how late the ticks of a periodic deadline fired.
+     * Jitter is reported as the standard deviation of the lateness.
+     */
+    struct DeadlineStats {
+        uint64_t ticks = 0;
+        uint64_t missed_deadlines = 0;
+        int64_t max_lateness_ns = 0;
+        double mean_lateness_ns = 0.0;
+        double lateness_m2 = 0.0; // Sum of squared deviations from the mean
+
+        /*!
+         * \brief Add the lateness of one tick to the statistics
+         * \param lateness_ns Time between the deadline and the tick actually starting in nanoseconds
+         */
+        void record(int64_t lateness_ns);
+
+        /*!
+         * \brief Standard deviation of the recorded lateness in nanoseconds
+         */
+        double jitterNs() const;
+    };
+
     /**
      * Trajectory Executor package primary worker class
      * 
@@ -58,6 +125,11 @@ namespace trajectory_executor {
              * \brief Constructor for TrajectoryExecutor. Uses default value for output tickrate.
              */
             TrajectoryExecutor();
+
+            /*!
+             * \brief Destructor, stops the trajectory emission thread if running
+             */
+            ~TrajectoryExecutor();
 /*!
              * \brief Monitor the guidance state and set the current trajector as null_ptr 
              */
@@ -70,6 +142,34 @@ namespace trajectory_executor {
              */
             bool init();
 
+            /*!
+             * \brief Initialize the TrajectoryExecutor instance inside a nodelet. CARMA node handles
+             * are created in the namespaces of the provided handles and share their callback queues
+             * so that trajectories from co-located nodelets are received by pointer
+             * 
+             * \param nh The nodelet's public node handle
+             * \param pnh The nodelet's private node handle
+             * \param remappings The nodelet's remapping arguments
+             * \return True if initialization was successful, false o.w.
+             */
+            bool init(const ros::NodeHandle &nh, const ros::NodeHandle &pnh, const ros::M_string &remappings);
+
+            /*!
+             * \brief Start the timer which emits trajectories to the control plugins.
+             * Called by run(), nodelets call it directly since the manager does the spinning.
+             */
+            void startTrajectoryTimer();
+
+            /*!
+             * \brief Stop the timer or deadline thread emitting trajectories
+             */
+            void stopTrajectoryTimer();
+
+            /*!
+             * \brief Get the tick timing statistics of the deadline scheduler
+             */
+            DeadlineStats getEmissionStats();
+
             /*!
              * \brief Begin processing of data and primary operation of TrajectoryExecutor.
              */
@@ -88,43 +188,93 @@ namespace trajectory_executor {
              * \brief Callback to be invoked when a new trajectory plan is
              * received on our inbound plan topic.
              * 
-             * \param msg The new TrajectoryPlan message
+             * \param msg The new TrajectoryPlan message, kept by reference without copying
              */
-            void onNewTrajectoryPlan(cav_msgs::TrajectoryPlan msg);
+            void onNewTrajectoryPlan(const cav_msgs::TrajectoryPlanConstPtr &msg);
 
             /*!
              * \brief Timer callback to be invoked at our output tickrate.
-             * Outputs current trajectory plan to the first control plugin in
-             * it's point list. If this is our second or later timestep on the
-             * same trajectory, consumes the first point in the point list before
-             * transmission.
+             * Outputs the remainder of the current control plugin's segment of
+             * the trajectory plan to that plugin. If this is our second or later
+             * timestep on the same trajectory, past points are skipped first.
+             * Once the next segment is within the handover lookahead it is also
+             * sent to its control plugin ahead of the handover.
              * 
              * \param te The timer event that triggered this callback
              */
             void onTrajEmitTick(const ros::TimerEvent& te);
 
+            /*!
+             * \brief Send the segment following the active one to its control plugin if
+             * its handover time is within the configured lookahead. Only called from the emission tick
+             */
+            void publishUpcomingSegment();
+
+            /*!
+             * \brief Body of the deadline scheduled emission thread. Sleeps until absolute
+             * deadlines at the trajectory publish rate on the monotonic clock and invokes
+             * onTrajEmitTick at each, recording how late the thread woke up.
+             */
+            void emissionLoop();
+
+            /*!
+             * \brief Timer callback used alongside the emission thread. Rethrows errors raised
+             * in the emission thread so they are reported through the node handle, and logs
+             * the tick timing statistics.
+             * 
+             * \param te The timer event that triggered this callback
+             */
+            void onEmissionMonitorTick(const ros::TimerEvent& te);
+
         private:
+            /*!
+             * \brief Set up subscribers and control plugin publishers on the already created node handles
+             * \return True if initialization was successful, false o.w.
+             */
+            bool setupInterfaces();
+
             // Node handles to separate callback queues
             std::unique_ptr<ros::CARMANodeHandle> _private_nh;
             std::unique_ptr<ros::CARMANodeHandle> _public_nh;
 
-            // Callback queues to ensure these threads process correctly
-            ros::CallbackQueue _timer_callbacks;
-            ros::CallbackQueue _msg_callbacks;
-
             ros::Subscriber _plan_sub; // Inbound plan subscriber
             ros::Subscriber _state_sub; // Guidance State subscriber
             std::map<std::string, ros::Publisher> _traj_publisher_map; // Outbound plan publishers
 
-            // Trajectory plan tracking data. Synchronized on _cur_traj_mutex
-            std::unique_ptr<cav_msgs::TrajectoryPlan> _cur_traj; 
+            /*!
+             * \brief A received plan with its controller segments. Immutable once built
+             */
+            struct ActivePlan {
+                cav_msgs::TrajectoryPlanConstPtr plan;
+                std::vector<ControllerSegment> segments;
+            };
+
+            // Latest plan handed from the message callbacks to the emission tick, a null plan clears the
+            // current trajectory. Only accessed through std::atomic_* so neither side waits on the other
+            std::shared_ptr<const ActivePlan> _pending_plan;
+
+            // Trajectory plan tracking data. Only accessed from the emission tick
+            std::shared_ptr<const ActivePlan> _cur_traj; // Past points are skipped via _cur_traj_start
+            size_t _cur_traj_start;
+            size_t _cur_segment;
             int _timesteps_since_last_traj;
-            std::mutex _cur_traj_mutex;
 
             // Timers and associated spin rates
             int _min_traj_publish_tickrate_hz;
             ros::Timer _timer;
             int _default_spin_rate;
+            int _control_plugin_queue_size;
+            double _handover_lookahead; // Seconds before a controller handover that the next segment is sent out
+
+            // Deadline scheduled emission, used in place of a ros::Timer tick when enabled.
+            // Message callbacks stay on the node handle's queue so they never delay a tick
+            bool _use_deadline_scheduler;
+            int _emission_thread_priority;
+            std::thread _emission_thread;
+            std::atomic<bool> _emission_running;
+            DeadlineStats _emission_stats; // Synchronized on _emission_mutex
+            std::string _emission_error; // Synchronized on _emission_mutex
+            std::mutex _emission_mutex;
     };
 }
 
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License") { you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <boost/make_shared.hpp>
+#include "trajectory_executor/trajectory_executor.hpp"
+
+/*!
+ * \brief Build a TrajectoryPlan with points spaced 100ns apart starting at start_nsec
+ */
+cav_msgs::TrajectoryPlan buildTimedTraj(uint64_t start_nsec, int num_points) {
+    cav_msgs::TrajectoryPlan plan;
+    plan.trajectory_id = "TEST TRAJECTORY";
+
+    for (int i = 0; i < num_points; i++) {
+        cav_msgs::TrajectoryPlanPoint p;
+        p.controller_plugin_name = "pure_pursuit";
+        p.target_time = start_nsec + i * 100;
+        p.x = i;
+        plan.trajectory_points.push_back(p);
+    }
+
+    return plan;
+}
+
+/*!
+ * \brief Test that the first future point is found by target time without modifying the plan
+ */
+TEST(TrajectoryExecutorTrimTest, test_find_first_future_point) {
+    cav_msgs::TrajectoryPlan plan = buildTimedTraj(1000, 10);
+
+    ASSERT_EQ(0, trajectory_executor::findFirstFuturePoint(plan, 999));
+    ASSERT_EQ(1, trajectory_executor::findFirstFuturePoint(plan, 1000));
+    ASSERT_EQ(5, trajectory_executor::findFirstFuturePoint(plan, 1450));
+    ASSERT_EQ(10, trajectory_executor::findFirstFuturePoint(plan, 5000));
+    // Points before the start index are never returned
+    ASSERT_EQ(7, trajectory_executor::findFirstFuturePoint(plan, 1000, 7));
+    ASSERT_EQ(10, plan.trajectory_points.size());
+}
+
+/*!
+ * \brief Test that a window over the whole plan shares the original message
+ */
+TEST(TrajectoryExecutorTrimTest, test_trajectory_window) {
+    cav_msgs::TrajectoryPlanConstPtr plan = boost::make_shared<const cav_msgs::TrajectoryPlan>(buildTimedTraj(1000, 10));
+
+    ASSERT_EQ(plan.get(), trajectory_executor::getTrajectoryWindow(plan, 0, 10).get());
+
+    cav_msgs::TrajectoryPlanConstPtr window = trajectory_executor::getTrajectoryWindow(plan, 3, 6);
+    ASSERT_EQ(3, window->trajectory_points.size());
+    ASSERT_EQ(3, window->trajectory_points[0].x);
+    ASSERT_EQ("TEST TRAJECTORY", window->trajectory_id);
+}
+
+/*!
+ * \brief Test that a plan is split into contiguous segments per control plugin
+ */
+TEST(TrajectoryExecutorTrimTest, test_split_by_controller) {
+    cav_msgs::TrajectoryPlan plan = buildTimedTraj(1000, 10);
+    ASSERT_EQ(1, trajectory_executor::splitByController(plan).size());
+
+    for (int i = 4; i < 7; i++) {
+        plan.trajectory_points[i].controller_plugin_name = "mpc";
+    }
+    plan.trajectory_points[9].controller_plugin_name = "mpc";
+
+    std::vector<trajectory_executor::ControllerSegment> segments = trajectory_executor::splitByController(plan);
+    ASSERT_EQ(4, segments.size());
+    ASSERT_EQ(0, segments[0].begin);
+    ASSERT_EQ(4, segments[0].end);
+    ASSERT_EQ("pure_pursuit", segments[0].controller_plugin_name);
+    ASSERT_EQ(4, segments[1].begin);
+    ASSERT_EQ(7, segments[1].end);
+    ASSERT_EQ("mpc", segments[1].controller_plugin_name);
+    ASSERT_EQ(7, segments[2].begin);
+    ASSERT_EQ(9, segments[2].end);
+    ASSERT_EQ(9, segments[3].begin);
+    ASSERT_EQ(10, segments[3].end);
+
+    ASSERT_TRUE(trajectory_executor::splitByController(cav_msgs::TrajectoryPlan()).empty());
+}
+
+/*!
+ * \brief Test that the deadline lateness statistics track mean, max and jitter
+ */
+TEST(TrajectoryExecutorTrimTest, test_deadline_stats) {
+    trajectory_executor::DeadlineStats stats;
+    ASSERT_EQ(0.0, stats.jitterNs());
+
+    stats.record(1000);
+    stats.record(3000);
+    stats.record(2000);
+
+    ASSERT_EQ(3, stats.ticks);
+    ASSERT_EQ(3000, stats.max_lateness_ns);
+    ASSERT_DOUBLE_EQ(2000.0, stats.mean_lateness_ns);
+    ASSERT_DOUBLE_EQ(1000.0, stats.jitterNs());
+}
+
+/*!
+ * \brief Main entrypoint for unit tests
+ */
+int main (int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -17,38 +17,109 @@
 #include "trajectory_executor/trajectory_executor.hpp"
 #include <ros/ros.h>
 #include <utility>
+#include <algorithm>
+#include <boost/make_shared.hpp>
 #include <cav_msgs/SystemAlert.h>
 #include <exception>
+#include <stdexcept>
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <time.h>
+#include <pthread.h>
 
 namespace trajectory_executor 
 {
     cav_msgs::TrajectoryPlan trimPastPoints(const cav_msgs::TrajectoryPlan &plan) {
-        cav_msgs::TrajectoryPlan out(plan);
-        out.trajectory_points = std::vector<cav_msgs::TrajectoryPlanPoint>();
+        cav_msgs::TrajectoryPlan out;
+        out.header = plan.header;
+        out.trajectory_id = plan.trajectory_id;
 
-        uint64_t current_nsec = ros::Time::now().toNSec();
+        size_t first_future = findFirstFuturePoint(plan, ros::Time::now().toNSec());
+        out.trajectory_points.assign(plan.trajectory_points.begin() + first_future, plan.trajectory_points.end());
 
-        for (int i = 0; i < plan.trajectory_points.size(); i++) {
-            if (plan.trajectory_points[i].target_time > current_nsec) {
-                out.trajectory_points.push_back(plan.trajectory_points[i]);
-            }
+        return out;
+    }
+
+    size_t findFirstFuturePoint(const cav_msgs::TrajectoryPlan &plan, uint64_t current_nsec, size_t start_index) {
+        auto begin = plan.trajectory_points.begin() + std::min(start_index, plan.trajectory_points.size());
+        auto first_future = std::upper_bound(begin, plan.trajectory_points.end(), current_nsec,
+            [](uint64_t time, const cav_msgs::TrajectoryPlanPoint &point) { return time < point.target_time; });
+
+        return first_future - plan.trajectory_points.begin();
+    }
+
+    cav_msgs::TrajectoryPlanConstPtr getTrajectoryWindow(const cav_msgs::TrajectoryPlanConstPtr &plan, size_t begin, size_t end) {
+        if (begin == 0 && end == plan->trajectory_points.size()) {
+            return plan;
         }
 
+        cav_msgs::TrajectoryPlanPtr out = boost::make_shared<cav_msgs::TrajectoryPlan>();
+        out->header = plan->header;
+        out->trajectory_id = plan->trajectory_id;
+        out->trajectory_points.assign(plan->trajectory_points.begin() + begin, plan->trajectory_points.begin() + end);
+
         return out;
     }
 
+    std::vector<ControllerSegment> splitByController(const cav_msgs::TrajectoryPlan &plan) {
+        std::vector<ControllerSegment> segments;
+        const auto &points = plan.trajectory_points;
+
+        for (size_t i = 0; i < points.size(); i++) {
+            if (segments.empty() || segments.back().controller_plugin_name != points[i].controller_plugin_name) {
+                segments.push_back({i, i + 1, points[i].controller_plugin_name});
+            } else {
+                segments.back().end = i + 1;
+            }
+        }
+
+        return segments;
+    }
+
+    void DeadlineStats::record(int64_t lateness_ns) {
+        ticks++;
+        max_lateness_ns = std::max(max_lateness_ns, lateness_ns);
+
+        // Welford's online update of the mean and variance
+        double delta = lateness_ns - mean_lateness_ns;
+        mean_lateness_ns += delta / ticks;
+        lateness_m2 += delta * (lateness_ns - mean_lateness_ns);
+    }
+
+    double DeadlineStats::jitterNs() const {
+        return ticks > 1 ? std::sqrt(lateness_m2 / (ticks - 1)) : 0.0;
+    }
+
     TrajectoryExecutor::TrajectoryExecutor(int traj_frequency) :
+        _cur_traj_start(0),
+        _cur_segment(0),
+        _timesteps_since_last_traj(0),
         _min_traj_publish_tickrate_hz(traj_frequency),
-        _timesteps_since_last_traj(0)
+        _handover_lookahead(0.0),
+        _use_deadline_scheduler(false),
+        _emission_thread_priority(0),
+        _emission_running(false)
     {
     }
 
     TrajectoryExecutor::TrajectoryExecutor() :
+        _cur_traj_start(0),
+        _cur_segment(0),
+        _timesteps_since_last_traj(0),
         _min_traj_publish_tickrate_hz(10),
-        _timesteps_since_last_traj(0)
+        _handover_lookahead(0.0),
+        _use_deadline_scheduler(false),
+        _emission_thread_priority(0),
+        _emission_running(false)
     {
     }
 
+    TrajectoryExecutor::~TrajectoryExecutor()
+    {
+        stopTrajectoryTimer();
+    }
+
     std::map<std::string, std::string> TrajectoryExecutor::queryControlPlugins()
     {
         // Hard coded stub for MVP since plugin manager won't be developed yet
@@ -66,46 +137,63 @@ namespace trajectory_executor
         return out;
     }
     
-    void TrajectoryExecutor::onNewTrajectoryPlan(cav_msgs::TrajectoryPlan msg)
+    void TrajectoryExecutor::onNewTrajectoryPlan(const cav_msgs::TrajectoryPlanConstPtr &msg)
     {
-        std::unique_lock<std::mutex> lock(_cur_traj_mutex); // Acquire lock until end of this function scope
         ROS_DEBUG("Received new trajectory plan!");
-        ROS_DEBUG_STREAM("New Trajectory plan ID: " << msg.trajectory_id);
-        ROS_DEBUG_STREAM("New plan contains " << msg.trajectory_points.size() << " points");
+        ROS_DEBUG_STREAM("New Trajectory plan ID: " << msg->trajectory_id);
+        ROS_DEBUG_STREAM("New plan contains " << msg->trajectory_points.size() << " points");
+
+        // Everything the tick needs is built here, the tick only picks up the finished pointer
+        std::shared_ptr<ActivePlan> active = std::make_shared<ActivePlan>();
+        active->plan = msg;
+        active->segments = splitByController(*msg);
+        ROS_DEBUG_STREAM("New plan spans " << active->segments.size() << " control plugin segments");
 
-        _cur_traj = std::unique_ptr<cav_msgs::TrajectoryPlan>(new cav_msgs::TrajectoryPlan(msg));
-        _timesteps_since_last_traj = 0;
+        std::atomic_store(&_pending_plan, std::shared_ptr<const ActivePlan>(std::move(active)));
         ROS_DEBUG_STREAM("Successfully swapped trajectories!");
     }
 
     void TrajectoryExecutor::guidanceStateMonitor(cav_msgs::GuidanceState msg)
     {
-        std::unique_lock<std::mutex> lock(_cur_traj_mutex); // Acquire lock until end of this function scope
         if(msg.state==cav_msgs::GuidanceState::INACTIVE)
         {
-        	_cur_traj= nullptr;
+        	std::atomic_store(&_pending_plan, std::make_shared<const ActivePlan>());
         }
         
     }
 
     void TrajectoryExecutor::onTrajEmitTick(const ros::TimerEvent& te)
     {
-        std::unique_lock<std::mutex> lock(_cur_traj_mutex);
         ROS_DEBUG("TrajectoryExecutor tick start!");
 
+        std::shared_ptr<const ActivePlan> pending = std::atomic_exchange(&_pending_plan, std::shared_ptr<const ActivePlan>());
+        if (pending) {
+            _cur_traj = pending->plan ? pending : nullptr;
+            _cur_traj_start = 0;
+            _cur_segment = 0;
+            _timesteps_since_last_traj = 0;
+        }
+
         if (_cur_traj != nullptr) {
+            const cav_msgs::TrajectoryPlanConstPtr &plan = _cur_traj->plan;
             if (_timesteps_since_last_traj > 0) {
-                _cur_traj = std::unique_ptr<cav_msgs::TrajectoryPlan>(new cav_msgs::TrajectoryPlan(trimPastPoints(*_cur_traj)));
+                _cur_traj_start = findFirstFuturePoint(*plan, ros::Time::now().toNSec(), _cur_traj_start);
             }
-            if (!_cur_traj->trajectory_points.empty()) {
+            if (_cur_traj_start < plan->trajectory_points.size()) {
                 // Determine the relevant control plugin for the current timestep
-                std::string control_plugin = _cur_traj->trajectory_points[0].controller_plugin_name;
+                while (_cur_traj->segments[_cur_segment].end <= _cur_traj_start) {
+                    _cur_segment++;
+                }
+                const ControllerSegment &segment = _cur_traj->segments[_cur_segment];
+                const std::string &control_plugin = segment.controller_plugin_name;
                 std::map<std::string, ros::Publisher>::iterator it = _traj_publisher_map.find(control_plugin);
                 if (it != _traj_publisher_map.end()) {
                     ROS_DEBUG("Found match for control plugin %s at point %d in current trajectory!",
                         control_plugin.c_str(),
                         _timesteps_since_last_traj);
-                    it->second.publish(*_cur_traj);
+                    // Published by pointer so intra-process subscribers share the message instead of copying it
+                    it->second.publish(getTrajectoryWindow(plan, _cur_traj_start, segment.end));
+                    publishUpcomingSegment();
                 } else {
                     std::ostringstream description_builder;
                     description_builder << "No match found for control plugin " 
@@ -124,19 +212,144 @@ namespace trajectory_executor
         ROS_DEBUG("TrajectoryExecutor tick completed succesfully!");
     }
 
-    void TrajectoryExecutor::run()
+    void TrajectoryExecutor::publishUpcomingSegment()
     {
-        ROS_DEBUG("Starting operations for TrajectoryExecutor component...");
+        if (_handover_lookahead <= 0.0 || _cur_segment + 1 >= _cur_traj->segments.size()) {
+            return;
+        }
+
+        const ControllerSegment &next = _cur_traj->segments[_cur_segment + 1];
+        ros::Time handover_time;
+        handover_time.fromNSec(_cur_traj->plan->trajectory_points[next.begin].target_time);
+        if (handover_time > ros::Time::now() + ros::Duration(_handover_lookahead)) {
+            return;
+        }
+
+        // Unknown control plugins are reported once their segment becomes active
+        std::map<std::string, ros::Publisher>::iterator it = _traj_publisher_map.find(next.controller_plugin_name);
+        if (it != _traj_publisher_map.end()) {
+            ROS_DEBUG_STREAM("Sending upcoming segment to " << next.controller_plugin_name << " ahead of handover at " << handover_time);
+            it->second.publish(getTrajectoryWindow(_cur_traj->plan, next.begin, next.end));
+        }
+    }
+
+    void TrajectoryExecutor::emissionLoop()
+    {
+        if (_emission_thread_priority > 0) {
+            sched_param param;
+            param.sched_priority = _emission_thread_priority;
+            int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            if (result != 0) {
+                ROS_WARN_STREAM("Could not set real-time priority " << _emission_thread_priority 
+                    << " for trajectory emission: " << std::strerror(result) << ". Running at normal priority.");
+            }
+        }
+
+        const int64_t period_ns = 1000000000LL / _min_traj_publish_tickrate_hz;
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        while (_emission_running) {
+            deadline.tv_nsec += period_ns;
+            while (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_nsec -= 1000000000L;
+                deadline.tv_sec++;
+            }
+
+            // Sleeping until an absolute deadline keeps tick time from drifting with the tick duration
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {}
+            if (!_emission_running) {
+                break;
+            }
+
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            int64_t lateness_ns = (now.tv_sec - deadline.tv_sec) * 1000000000LL + (now.tv_nsec - deadline.tv_nsec);
+            // Deadlines that already passed are skipped rather than fired back to back
+            int64_t missed = lateness_ns / period_ns;
+            if (missed > 0) {
+                int64_t skipped_ns = deadline.tv_nsec + missed * period_ns;
+                deadline.tv_sec += skipped_ns / 1000000000LL;
+                deadline.tv_nsec = skipped_ns % 1000000000LL;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_emission_mutex);
+                _emission_stats.record(lateness_ns);
+                _emission_stats.missed_deadlines += missed;
+            }
+
+            try {
+                ros::TimerEvent te;
+                te.current_real = ros::Time::now();
+                onTrajEmitTick(te);
+            } catch (const std::exception &e) {
+                std::lock_guard<std::mutex> lock(_emission_mutex);
+                _emission_error = e.what();
+                _emission_running = false;
+            }
+        }
+    }
+
+    void TrajectoryExecutor::onEmissionMonitorTick(const ros::TimerEvent& te)
+    {
+        std::unique_lock<std::mutex> lock(_emission_mutex);
+        if (!_emission_error.empty()) {
+            // Rethrown here so the node handle reports it as it would for a timer driven tick
+            throw std::runtime_error(_emission_error);
+        }
+
+        ROS_DEBUG_STREAM_THROTTLE(5.0, "Trajectory emission ticks: " << _emission_stats.ticks
+            << " missed deadlines: " << _emission_stats.missed_deadlines
+            << " mean lateness: " << _emission_stats.mean_lateness_ns / 1e6 << "ms"
+            << " max lateness: " << _emission_stats.max_lateness_ns / 1e6 << "ms"
+            << " jitter: " << _emission_stats.jitterNs() / 1e6 << "ms");
+    }
+
+    DeadlineStats TrajectoryExecutor::getEmissionStats()
+    {
+        std::lock_guard<std::mutex> lock(_emission_mutex);
+        return _emission_stats;
+    }
+
+    void TrajectoryExecutor::startTrajectoryTimer()
+    {
+        if (_use_deadline_scheduler) {
+            _emission_running = true;
+            _emission_thread = std::thread(&TrajectoryExecutor::emissionLoop, this);
+            _timer = _private_nh->createTimer(
+                ros::Duration(ros::Rate(this->_default_spin_rate)),
+                &TrajectoryExecutor::onEmissionMonitorTick, 
+                this);
+            return;
+        }
+
         _timer = _private_nh->createTimer(
             ros::Duration(ros::Rate(this->_min_traj_publish_tickrate_hz)),
             &TrajectoryExecutor::onTrajEmitTick, 
             this);
+    }
+
+    void TrajectoryExecutor::stopTrajectoryTimer()
+    {
+        _timer.stop();
+        _emission_running = false;
+        if (_emission_thread.joinable()) {
+            _emission_thread.join();
+        }
+    }
+
+    void TrajectoryExecutor::run()
+    {
+        ROS_DEBUG("Starting operations for TrajectoryExecutor component...");
+        startTrajectoryTimer();
 
         ROS_DEBUG("TrajectoryExecutor component started succesfully! Starting to spin.");
 
         ros::CARMANodeHandle::setSpinRate(_default_spin_rate);
         ros::CARMANodeHandle::spin();
 
+        stopTrajectoryTimer();
         ros::shutdown();
     }
 
@@ -148,15 +361,38 @@ namespace trajectory_executor
         _private_nh = std::unique_ptr<ros::CARMANodeHandle>(new ros::CARMANodeHandle("~"));
         ROS_DEBUG("Initialized all node handles");
 
+        return setupInterfaces();
+    }
+
+    bool TrajectoryExecutor::init(const ros::NodeHandle &nh, const ros::NodeHandle &pnh, const ros::M_string &remappings)
+    {
+        ROS_DEBUG("Initializing TrajectoryExecutor nodelet...");
+
+        // CARMA node handles are still used so exceptions in callbacks raise system alerts as they do in the node
+        _public_nh = std::unique_ptr<ros::CARMANodeHandle>(new ros::CARMANodeHandle(nh.getNamespace(), remappings));
+        _public_nh->setCallbackQueue(nh.getCallbackQueue());
+        _private_nh = std::unique_ptr<ros::CARMANodeHandle>(new ros::CARMANodeHandle(pnh.getNamespace(), remappings));
+        _private_nh->setCallbackQueue(pnh.getCallbackQueue());
+        ROS_DEBUG("Initialized all node handles");
+
+        return setupInterfaces();
+    }
+
+    bool TrajectoryExecutor::setupInterfaces()
+    {
         _private_nh->param("spin_rate", _default_spin_rate, 10);
         _private_nh->param("trajectory_publish_rate", _min_traj_publish_tickrate_hz, 10);
+        _private_nh->param("control_plugin_queue_size", _control_plugin_queue_size, 1000);
+        _private_nh->param("controller_handover_lookahead", _handover_lookahead, 0.0);
+        _private_nh->param("use_deadline_scheduler", _use_deadline_scheduler, false);
+        _private_nh->param("emission_thread_priority", _emission_thread_priority, 0);
 
         ROS_DEBUG_STREAM("Initalized params with default_spin_rate " << _default_spin_rate 
             << " and trajectory_publish_rate " << _min_traj_publish_tickrate_hz);
 
         this->_plan_sub = this->_public_nh->subscribe<cav_msgs::TrajectoryPlan>("trajectory", 5, &TrajectoryExecutor::onNewTrajectoryPlan, this);
         this->_state_sub = this->_public_nh->subscribe<cav_msgs::GuidanceState>("state", 5, &TrajectoryExecutor::guidanceStateMonitor, this);
-        this->_cur_traj = std::unique_ptr<cav_msgs::TrajectoryPlan>();
+        this->_cur_traj = nullptr;
         ROS_DEBUG("Subscribed to inbound trajectory plans.");
 
         ROS_DEBUG("Setting up publishers for control plugin topics...");
@@ -167,7 +403,7 @@ namespace trajectory_executor
         for (auto it = discovered_control_plugins.begin(); it != discovered_control_plugins.end(); it++)
         {
             ROS_DEBUG("Trajectory executor discovered control plugin %s listening on topic %s.", it->first.c_str(), it->second.c_str());
-            ros::Publisher control_plugin_pub = _public_nh->advertise<cav_msgs::TrajectoryPlan>(it->second, 1000);
+            ros::Publisher control_plugin_pub = _public_nh->advertise<cav_msgs::TrajectoryPlan>(it->second, _control_plugin_queue_size);
             control_plugin_topics.insert(std::make_pair(it->first, control_plugin_pub));
         }
 
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <memory>
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+#include "trajectory_executor/trajectory_executor.hpp"
+
+namespace trajectory_executor
+{
+    /**
+     * Nodelet wrapper of the TrajectoryExecutor
+     * 
+     * When loaded into the same manager as the plan delegator and the control
+     * plugins, trajectories are received and forwarded by pointer without
+     * serialization.
+     */
+    class TrajectoryExecutorNodelet : public nodelet::Nodelet {
+        private:
+            std::unique_ptr<TrajectoryExecutor> _executor;
+
+            void onInit() override {
+                _executor = std::unique_ptr<TrajectoryExecutor>(new TrajectoryExecutor());
+                _executor->init(getNodeHandle(), getPrivateNodeHandle(), getRemappingArgs());
+                _executor->startTrajectoryTimer();
+            }
+    };
+}
+
+PLUGINLIB_EXPORT_CLASS(trajectory_executor::TrajectoryExecutorNodelet, nodelet::Nodelet)